@@ -0,0 +1,84 @@
+#include "alp.hpp"
+#include "bench_alp.hpp"
+#include <random>
+
+using namespace alp::config;
+
+/* Bench the ffor, unffor and falp kernels of every ISA this CPU supports, at every 64-bit bit width. */
+static __attribute__((noinline)) benchmark::BenchmarkReporter::Run bench_kernel(int                benchmark_number,
+                                                                                const std::string& kernel,
+                                                                                uint8_t            bw,
+                                                                                const uint64_t*    in_arr,
+                                                                                uint64_t*          packed_arr,
+                                                                                uint64_t*          unpacked_arr,
+                                                                                double*            dbl_arr) {
+#ifdef NDEBUG
+	uint64_t iterations = 300000;
+#else
+	uint64_t iterations = 1;
+#endif
+
+	std::string benchmark_name =
+	    std::string(fastlanes::isa_name(fastlanes::get_isa())) + "_" + kernel + "_" + std::to_string(bw) + "bw";
+	uint64_t base = 0;
+
+	uint64_t cycles = benchmark::cycleclock::Now();
+	if (kernel == "ffor") {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			ffor::ffor(in_arr, packed_arr, bw, &base);
+		}
+	} else if (kernel == "unffor") {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			unffor::unffor(packed_arr, unpacked_arr, bw, &base);
+		}
+	} else {
+		for (uint64_t i = 0; i < iterations; ++i) {
+			generated::falp::dispatch::falp(packed_arr, dbl_arr, bw, &base, 0, 2);
+		}
+	}
+	cycles = benchmark::cycleclock::Now() - cycles;
+
+	return benchmark::BenchmarkReporter::Run(
+	    benchmark_number, benchmark_name, iterations, double(cycles) / (double(iterations) * VECTOR_SIZE));
+}
+
+void benchmark_all(benchmark::Benchmark& benchmark) {
+	auto* in_arr       = new (std::align_val_t {64}) uint64_t[VECTOR_SIZE];
+	auto* packed_arr   = new (std::align_val_t {64}) uint64_t[VECTOR_SIZE];
+	auto* unpacked_arr = new (std::align_val_t {64}) uint64_t[VECTOR_SIZE];
+	auto* dbl_arr      = new (std::align_val_t {64}) double[VECTOR_SIZE];
+
+	std::mt19937_64 random(42);
+	int             benchmark_number {0};
+	for (auto isa : {fastlanes::ISA::FALLBACK, fastlanes::ISA::AVX2, fastlanes::ISA::AVX512BW}) {
+		if (!fastlanes::is_supported(isa)) { continue; }
+		fastlanes::set_isa(isa);
+		for (uint8_t bw {0}; bw <= 64; ++bw) {
+			for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+				in_arr[i] = bw == 64 ? random() : random() & ((1ULL << bw) - 1);
+			}
+			for (const auto* kernel : {"ffor", "unffor", "falp"}) {
+				benchmark.Run(bench_kernel(benchmark_number++, kernel, bw, in_arr, packed_arr, unpacked_arr, dbl_arr));
+			}
+
+			// Validate
+			for (size_t i = 0; i < VECTOR_SIZE; ++i) {
+				if (in_arr[i] != unpacked_arr[i] || static_cast<double>(static_cast<int64_t>(in_arr[i])) * alp::Constants<double>::FRAC_ARR[2] != dbl_arr[i]) {
+					std::cerr << fastlanes::isa_name(isa) << " " << static_cast<int>(bw) << "bw, " << i << "\n";
+					std::exit(-1);
+				}
+			}
+		}
+	}
+	fastlanes::set_isa(fastlanes::detect_isa());
+}
+
+int main() {
+	benchmark::Benchmark benchmark =
+	    benchmark::create("fastlanes_kernels")
+	        .save()
+	        .at(std::string(SOURCE_DIR) + "/alp_pub/results/" + benchmark::CmakeInfo::getCmakeToolchainFile())
+	        .print()
+	        .add_extra_info(benchmark::CmakeInfo::getCmakeInfo());
+	benchmark_all(benchmark);
+}
@@ -10,7 +10,9 @@
 #include "alp/falp.hpp"
 #include "alp/rd.hpp"
 #include "alp/sampler.hpp"
+#include "alp/sampling_cache.hpp"
 #include "alp/storer.hpp"
+#include "alp/stream.hpp"
 #include "alp/utils.hpp"
 #include "fastlanes/ffor.hpp"
 #include "fastlanes/unffor.hpp"
@@ -3,10 +3,12 @@
 
 #include "alp/encode.hpp"
 #include "alp/rd.hpp"
+#include "alp/sampling_cache.hpp"
 #include "alp/state.hpp"
 #include "alp/storer.hpp"
 #include "alp/utils.hpp"
 #include "fastlanes/ffor.hpp"
+#include <chrono>
 
 namespace alp {
 
@@ -40,6 +42,13 @@ struct AlpCompressor {
 
 	EXACT_TYPE right_for_base = 0; // Always 0
 
+	// Keep the rowgroup sampling result across rowgroups and compress() calls (see AlpSamplingCache)
+	bool                reuse_sampling = false;
+	AlpSamplingCache<T> sampling_cache;
+
+	// Time spent choosing the scheme and combinations of rowgroups, by sampling or by revalidating the cache
+	std::chrono::steady_clock::duration sampling_time {};
+
 	AlpCompressor() {}
 
 	size_t get_size() { return storer.get_size(); }
@@ -71,22 +80,50 @@ struct AlpCompressor {
 		ffor::ffor(left_parts, left_parts_encoded, stt.left_bit_width, &stt.left_for_base);
 	}
 
+	void sample_rowgroup(T* values, size_t current_idx, size_t values_count) {
+		AlpEncode<T>::init(values, current_idx, values_count, sample_array, stt);
+		if (stt.scheme == SCHEME::ALP_RD) {
+			AlpRD<T>::init(values, current_idx, values_count, sample_array, stt);
+			left_bp_size  = AlpApiUtils<T>::get_size_after_bitpacking(stt.left_bit_width);
+			right_bp_size = AlpApiUtils<T>::get_size_after_bitpacking(stt.right_bit_width);
+		}
+	}
+
+	//! Chooses the scheme of the rowgroup starting at current_idx and stores the rowgroup metadata
+	void start_rowgroup(T* values, size_t current_idx, size_t values_count) {
+		auto sampling_start_time = std::chrono::steady_clock::now();
+		if (!reuse_sampling || !sampling_cache.revalidate(values, current_idx, values_count, stt)) {
+			sample_rowgroup(values, current_idx, values_count);
+			if (reuse_sampling) { sampling_cache.update(values, current_idx, values_count, stt); }
+		}
+		sampling_time += std::chrono::steady_clock::now() - sampling_start_time;
+		store_rowgroup_metadata();
+	}
+
+	//! Compresses and stores the first n_values of input_vector as the last vector, padded to VECTOR_SIZE
+	void compress_incomplete_vector(size_t n_values) {
+		stt.vector_size = n_values;
+		if (stt.scheme == SCHEME::ALP_RD) {
+			AlpApiUtils<T>::fill_incomplete_alprd_vector(input_vector, stt);
+		} else {
+			AlpApiUtils<T>::fill_incomplete_alp_vector(
+			    input_vector, exceptions, exceptions_position, &stt.exceptions_count, encoded_integers, stt);
+		}
+		compress_vector();
+		store_vector();
+	}
+
 	void compress(T* values, size_t values_count, uint8_t* out) {
 		storer                  = storer::MemStorer<DRY>(out);
 		size_t rouwgroup_count  = AlpApiUtils<T>::get_rowgroup_count(values_count);
 		size_t current_idx      = 0;
 		size_t left_to_compress = values_count;
+		stt.vector_size         = config::VECTOR_SIZE;
 		for (size_t current_rowgroup = 0; current_rowgroup < rouwgroup_count; current_rowgroup++) {
 			/*
 			 * Rowgroup level
 			 */
-			AlpEncode<T>::init(values, current_idx, values_count, sample_array, stt);
-			if (stt.scheme == SCHEME::ALP_RD) {
-				AlpRD<T>::init(values, current_idx, values_count, sample_array, stt);
-				left_bp_size  = AlpApiUtils<T>::get_size_after_bitpacking(stt.left_bit_width);
-				right_bp_size = AlpApiUtils<T>::get_size_after_bitpacking(stt.right_bit_width);
-			}
-			store_rowgroup_metadata();
+			start_rowgroup(values, current_idx, values_count);
 
 			size_t values_left_in_rowgroup = std::min(config::ROWGROUP_SIZE, left_to_compress);
 			size_t vectors_in_rowgroup     = AlpApiUtils<T>::get_complete_vector_count(values_left_in_rowgroup);
@@ -103,18 +140,10 @@ struct AlpCompressor {
 			}
 		}
 		if (left_to_compress) { // Last vector which may be incomplete
-			stt.vector_size = left_to_compress;
 			for (size_t idx = 0; idx < left_to_compress; idx++) {
 				input_vector[idx] = values[current_idx++];
 			}
-			if (stt.scheme == SCHEME::ALP_RD) {
-				AlpApiUtils<T>::fill_incomplete_alprd_vector(input_vector, stt);
-			} else {
-				AlpApiUtils<T>::fill_incomplete_alp_vector(
-				    input_vector, exceptions, exceptions_position, &stt.exceptions_count, encoded_integers, stt);
-			}
-			compress_vector();
-			store_vector();
+			compress_incomplete_vector(left_to_compress);
 		}
 	};
 
@@ -2,6 +2,7 @@
 #define ALP_CONFIG_HPP
 
 #include <cstddef>
+#include <cstdint>
 
 /*
  * ALP Configs
@@ -22,6 +23,12 @@ inline constexpr size_t MAX_K_COMBINATIONS     = 5;
 inline constexpr size_t CUTTING_LIMIT          = 16;
 inline constexpr size_t MAX_RD_DICT_BIT_WIDTH  = 3;
 inline constexpr size_t MAX_RD_DICTIONARY_SIZE = (1 << MAX_RD_DICT_BIT_WIDTH);
+/// Values of a rowgroup on which a cached sampling result is revalidated
+inline constexpr size_t CACHE_REVALIDATION_SAMPLES = 16;
+/// A cached sampling result is searched again when its estimated size grows by more than this factor
+inline constexpr double CACHE_REGRESSION_LIMIT = 1.1;
+/// Rowgroups that may reuse a cached sampling result before it is searched again anyway
+inline constexpr uint32_t CACHE_MAX_REUSES = 64;
 
 } // namespace alp::config
 
@@ -2,9 +2,11 @@
 #define ALP_DECOMPRESSOR_HPP
 
 #include "alp/decode.hpp"
+#include "alp/falp.hpp"
 #include "alp/storer.hpp"
 #include "alp/utils.hpp"
 #include "fastlanes/unffor.hpp"
+#include <type_traits>
 
 namespace alp {
 
@@ -21,6 +23,9 @@ struct AlpDecompressor {
 
 	size_t out_offset = 0;
 
+	// Decode double ALP vectors with the fused FALP kernel (unffor and decode in one pass)
+	bool use_falp = true;
+
 	T        exceptions[config::VECTOR_SIZE];
 	int64_t  encoded_integers[config::VECTOR_SIZE];
 	int64_t  alp_encoded_array[config::VECTOR_SIZE];
@@ -82,6 +87,22 @@ struct AlpDecompressor {
 		}
 	}
 
+	void decode_alp_vector(T* out) {
+		if constexpr (std::is_same_v<T, double>) {
+			if (use_falp) {
+				generated::falp::dispatch::falp(reinterpret_cast<const uint64_t*>(alp_encoded_array),
+				                                out,
+				                                stt.bit_width,
+				                                reinterpret_cast<const uint64_t*>(&stt.for_base),
+				                                stt.fac,
+				                                stt.exp);
+				return;
+			}
+		}
+		unffor::unffor(alp_encoded_array, encoded_integers, stt.bit_width, &stt.for_base);
+		AlpDecode<T>::decode(encoded_integers, stt.fac, stt.exp, out);
+	}
+
 	void decompress_vector(T* out) {
 		if (stt.scheme == SCHEME::ALP_RD) {
 			unffor::unffor(right_parts_encoded, right_parts, stt.right_bit_width, &right_for_base);
@@ -94,8 +115,7 @@ struct AlpDecompressor {
 			                 &stt.exceptions_count,
 			                 stt);
 		} else {
-			unffor::unffor(alp_encoded_array, encoded_integers, stt.bit_width, &stt.for_base);
-			AlpDecode<T>::decode(encoded_integers, stt.fac, stt.exp, (out + out_offset));
+			decode_alp_vector(out + out_offset);
 			AlpDecode<T>::patch_exceptions((out + out_offset), exceptions, exceptions_position, &stt.exceptions_count);
 		}
 	}
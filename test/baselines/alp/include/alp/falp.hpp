@@ -7,6 +7,7 @@
 #ifndef ALP_FALP_HPP
 #define ALP_FALP_HPP
 
+#include "fastlanes/isa.hpp"
 #include <cstdint>
 
 namespace generated { namespace falp {
@@ -106,6 +107,15 @@ void falp(const uint64_t* __restrict in,
           uint8_t exponent);
 } // namespace sve
 } // namespace arm64v8
+//! The kernel of fastlanes::get_isa()
+namespace dispatch {
+void falp(const uint64_t* __restrict in,
+          double* __restrict out,
+          uint8_t bw,
+          const uint64_t* __restrict a_base_p,
+          uint8_t factor,
+          uint8_t exponent);
+} // namespace dispatch
 }} // namespace generated::falp
 
 #endif // FALP_HPP
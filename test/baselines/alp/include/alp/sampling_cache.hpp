@@ -0,0 +1,129 @@
+#ifndef ALP_SAMPLING_CACHE_HPP
+#define ALP_SAMPLING_CACHE_HPP
+
+#include "alp/config.hpp"
+#include "alp/constants.hpp"
+#include "alp/decode.hpp"
+#include "alp/encode.hpp"
+#include "alp/rd.hpp"
+#include "alp/state.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace alp {
+
+/*
+ * Carries the result of rowgroup sampling (the scheme and either the top k combinations or the ALP_RD
+ * dictionary, all of which live in the compressor state) over to the next rowgroups, across compress() calls.
+ * Neighbouring blocks of a time series rarely change their best combinations, and the brute force search of
+ * the first level sample costs more than encoding the block itself.
+ *
+ * Before a rowgroup reuses the state it is revalidated: the state's estimated bits per value over a tiny
+ * equidistant sample of the rowgroup is compared with the same estimate on the rowgroup the state was searched
+ * on. A full search runs again when the estimate regresses past CACHE_REGRESSION_LIMIT, when the best cached
+ * combination with a bigger factor (fewer decimals) would do better, which no regression shows, or after
+ * CACHE_MAX_REUSES reuses so that a switch between ALP and ALP_RD is not missed for long.
+ */
+template <class T>
+struct AlpSamplingCache {
+
+	using EXACT_TYPE = typename FloatingToExact<T>::type;
+
+	bool     valid {false};
+	double   reference_bits_per_value {0};
+	uint32_t reuses {0};
+
+	uint64_t full_searches {0};
+	uint64_t revalidations {0};
+
+	void clear() { valid = false; }
+
+	//! Whether the rowgroup starting at offset may reuse stt as it is
+	bool revalidate(const T* data, const size_t offset, const size_t count, const state& stt) {
+		if (!valid || reuses >= config::CACHE_MAX_REUSES) { return false; }
+		const double bits_per_value = estimate_bits_per_value(data, offset, count, stt);
+		if (bits_per_value > reference_bits_per_value * config::CACHE_REGRESSION_LIMIT) { return false; }
+		if (stt.scheme == SCHEME::ALP) {
+			const int exp_idx = stt.best_k_combinations[0].first;
+			for (int factor_idx = stt.best_k_combinations[0].second + 1; factor_idx <= exp_idx; factor_idx++) {
+				if (estimate_combination_bits_per_value(data, offset, count, exp_idx, factor_idx) < bits_per_value) {
+					return false;
+				}
+			}
+		}
+		reuses++;
+		revalidations++;
+		return true;
+	}
+
+	//! Records the state a full search found for the rowgroup starting at offset
+	void update(const T* data, const size_t offset, const size_t count, const state& stt) {
+		reference_bits_per_value = estimate_bits_per_value(data, offset, count, stt);
+		reuses                   = 0;
+		valid                    = true;
+		full_searches++;
+	}
+
+	static double estimate_bits_per_value(const T* data, const size_t offset, const size_t count, const state& stt) {
+		if (stt.scheme == SCHEME::ALP_RD) {
+			const size_t samples_n  = revalidation_samples(offset, count);
+			const size_t increments = std::min(config::ROWGROUP_SIZE, count - offset) / samples_n;
+			const auto*  in         = reinterpret_cast<const EXACT_TYPE*>(data + offset);
+			exp_c_t      exceptions_count {0};
+			for (size_t i = 0; i < samples_n; i++) {
+				const auto left_part = static_cast<uint16_t>(in[i * increments] >> stt.right_bit_width);
+				const auto it        = stt.left_parts_dict_map.find(left_part);
+				if (it == stt.left_parts_dict_map.end() || it->second >= stt.actual_dictionary_size) {
+					exceptions_count++;
+				}
+			}
+			return AlpRD<T>::estimate_compression_size(
+			    stt.right_bit_width, stt.left_bit_width, exceptions_count, samples_n);
+		}
+
+		// The best of the top k combinations, as the second level sampling would pick it
+		double best_bits_per_value = std::numeric_limits<double>::max();
+		for (size_t k = 0; k < stt.k_combinations; k++) {
+			best_bits_per_value =
+			    std::min(best_bits_per_value,
+			             estimate_combination_bits_per_value(
+			                 data, offset, count, stt.best_k_combinations[k].first, stt.best_k_combinations[k].second));
+		}
+		return best_bits_per_value;
+	}
+
+	static double estimate_combination_bits_per_value(
+	    const T* data, const size_t offset, const size_t count, const int exp_idx, const int factor_idx) {
+		const size_t samples_n  = revalidation_samples(offset, count);
+		const size_t increments = std::min(config::ROWGROUP_SIZE, count - offset) / samples_n;
+		exp_c_t      exceptions_count {0};
+		int64_t      max_encoded_value {std::numeric_limits<int64_t>::min()};
+		int64_t      min_encoded_value {std::numeric_limits<int64_t>::max()};
+		for (size_t i = 0; i < samples_n; i++) {
+			const T       actual_value  = data[offset + i * increments];
+			const int64_t encoded_value = AlpEncode<T>::encode_value(actual_value, factor_idx, exp_idx);
+			if (AlpDecode<T>::decode_value(encoded_value, factor_idx, exp_idx) == actual_value) {
+				max_encoded_value = std::max(max_encoded_value, encoded_value);
+				min_encoded_value = std::min(min_encoded_value, encoded_value);
+			} else {
+				exceptions_count++;
+			}
+		}
+		const uint64_t delta = exceptions_count == samples_n ? 0
+		                                                     : static_cast<uint64_t>(max_encoded_value) -
+		                                                           static_cast<uint64_t>(min_encoded_value);
+		return std::ceil(std::log2(static_cast<double>(delta) + 1)) +
+		       static_cast<double>(exceptions_count) * (Constants<T>::EXCEPTION_SIZE + EXCEPTION_POSITION_SIZE) /
+		           samples_n;
+	}
+
+	static size_t revalidation_samples(const size_t offset, const size_t count) {
+		return std::min(config::CACHE_REVALIDATION_SAMPLES, std::min(config::ROWGROUP_SIZE, count - offset));
+	}
+};
+
+} // namespace alp
+
+#endif // ALP_SAMPLING_CACHE_HPP
@@ -0,0 +1,165 @@
+#ifndef ALP_STREAM_HPP
+#define ALP_STREAM_HPP
+
+#include "alp/compressor.hpp"
+#include "alp/decompressor.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace alp {
+
+/*
+ * Push-style ALP compression: values are appended in any amounts, and every vector is compressed and handed to
+ * the sink as soon as its VECTOR_SIZE values are in. close() flushes the incomplete last vector. The bytes are laid
+ * out as AlpCompressor::compress lays them out, so AlpDecompressor (given values_count()) or AlpStreamReader read
+ * them back.
+ *
+ * The stream cannot look ahead, so the scheme of a rowgroup comes from sampling its first vector. Since the
+ * exponent and factor are stored per vector, the combinations of an ALP rowgroup are revalidated on every vector
+ * (see AlpSamplingCache) and searched again on the vector when they regress. The ALP_RD dictionary stays fixed for
+ * the rowgroup. The sampling result also carries over to the next rowgroup, and to the next stream after close().
+ */
+template <class T>
+struct AlpStreamWriter {
+
+	using Sink = std::function<void(const uint8_t* bytes, size_t size)>;
+
+	//! Upper bound of the bytes of one vector, with the rowgroup metadata before it
+	static constexpr size_t MAX_VECTOR_BYTES =
+	    config::VECTOR_SIZE * (sizeof(uint64_t) + sizeof(T) + EXCEPTION_POSITION_SIZE_BYTES) + 1024;
+
+	static constexpr size_t VECTORS_PER_ROWGROUP = config::ROWGROUP_SIZE / config::VECTOR_SIZE;
+
+	explicit AlpStreamWriter(Sink sink)
+	    : sink(std::move(sink))
+	    , compressor(std::make_unique<AlpCompressor<T>>())
+	    , vector_bytes(MAX_VECTOR_BYTES) {
+		compressor->reuse_sampling = true;
+	}
+
+	void append(const T* values, size_t n_values) {
+		while (n_values > 0) {
+			const size_t n = std::min(n_values, config::VECTOR_SIZE - buffered_n);
+			std::copy(values, values + n, compressor->input_vector + buffered_n);
+			buffered_n += n;
+			values += n;
+			n_values -= n;
+			if (buffered_n == config::VECTOR_SIZE) { flush_vector(); }
+		}
+	}
+
+	//! Flushes the incomplete last vector and ends the stream; the writer may start another one afterwards
+	void close() {
+		if (buffered_n > 0) { flush_vector(); }
+		compressor->stt.vector_size = config::VECTOR_SIZE;
+		vector_idx_in_rowgroup      = 0;
+		stream_values_n             = 0;
+		stream_bytes_n              = 0;
+	}
+
+	//! Values appended to the current stream, including the ones not flushed yet
+	size_t values_count() const { return stream_values_n + buffered_n; }
+
+	//! Bytes handed to the sink for the current stream
+	size_t size() const { return stream_bytes_n; }
+
+	const AlpCompressor<T>& get_compressor() const { return *compressor; }
+
+private:
+	void flush_vector() {
+		auto& stt          = compressor->stt;
+		compressor->storer = storer::MemStorer<>(vector_bytes.data());
+		if (vector_idx_in_rowgroup == 0) {
+			compressor->start_rowgroup(compressor->input_vector, 0, buffered_n);
+		} else if (stt.scheme == SCHEME::ALP) {
+			revalidate_combinations();
+		}
+
+		if (buffered_n == config::VECTOR_SIZE) {
+			compressor->compress_vector();
+			compressor->store_vector();
+		} else {
+			compressor->compress_incomplete_vector(buffered_n);
+		}
+		sink(vector_bytes.data(), compressor->get_size());
+
+		stream_bytes_n += compressor->get_size();
+		stream_values_n += buffered_n;
+		buffered_n             = 0;
+		vector_idx_in_rowgroup = (vector_idx_in_rowgroup + 1) % VECTORS_PER_ROWGROUP;
+	}
+
+	void revalidate_combinations() {
+		auto& stt                 = compressor->stt;
+		auto& cache               = compressor->sampling_cache;
+		auto  sampling_start_time = std::chrono::steady_clock::now();
+		if (!cache.revalidate(compressor->input_vector, 0, buffered_n, stt)) {
+			const auto combinations   = stt.best_k_combinations;
+			const auto k_combinations = stt.k_combinations;
+			AlpEncode<T>::init(compressor->input_vector, 0, buffered_n, compressor->sample_array, stt);
+			if (stt.scheme == SCHEME::ALP_RD) {
+				// The scheme is fixed until the rowgroup ends; the next rowgroup searches again. The kept
+				// combinations become the reference on this vector, so the rest of the rowgroup revalidates
+				// against it instead of searching again on every vector.
+				stt.scheme              = SCHEME::ALP;
+				stt.best_k_combinations = combinations;
+				stt.k_combinations      = k_combinations;
+			}
+			cache.update(compressor->input_vector, 0, buffered_n, stt);
+		}
+		compressor->sampling_time += std::chrono::steady_clock::now() - sampling_start_time;
+	}
+
+	Sink                              sink;
+	std::unique_ptr<AlpCompressor<T>> compressor;
+	std::vector<uint8_t>              vector_bytes;
+	size_t                            buffered_n {0};
+	size_t                            vector_idx_in_rowgroup {0};
+	size_t                            stream_values_n {0};
+	size_t                            stream_bytes_n {0};
+};
+
+/*
+ * Reads the vectors of a compressed stream one at a time, from AlpStreamWriter or AlpCompressor::compress.
+ */
+template <class T>
+struct AlpStreamReader {
+
+	static constexpr size_t VECTORS_PER_ROWGROUP = config::ROWGROUP_SIZE / config::VECTOR_SIZE;
+
+	AlpStreamReader(uint8_t* in, size_t values_count)
+	    : decompressor(std::make_unique<AlpDecompressor<T>>())
+	    , values_left(values_count) {
+		decompressor->reader = storer::MemReader(in);
+	}
+
+	//! Decompresses the next vector into out, which must hold VECTOR_SIZE values. Returns how many of them belong
+	//! to the stream, 0 at its end.
+	size_t next_vector(T* out) {
+		if (values_left == 0) { return 0; }
+		if (vector_idx_in_rowgroup == 0) { decompressor->stt.scheme = decompressor->load_rowgroup_metadata(); }
+		decompressor->load_vector();
+		decompressor->out_offset = 0;
+		decompressor->decompress_vector(out);
+
+		const size_t n_values  = std::min(values_left, config::VECTOR_SIZE);
+		values_left           -= n_values;
+		vector_idx_in_rowgroup = (vector_idx_in_rowgroup + 1) % VECTORS_PER_ROWGROUP;
+		return n_values;
+	}
+
+	size_t get_values_left() const { return values_left; }
+
+	//! Bytes consumed so far
+	size_t get_size() const { return decompressor->reader.buffer_offset; }
+
+private:
+	std::unique_ptr<AlpDecompressor<T>> decompressor;
+	size_t                              values_left;
+	size_t                              vector_idx_in_rowgroup {0};
+};
+
+} // namespace alp
+
+#endif // ALP_STREAM_HPP
@@ -1,6 +1,7 @@
 #ifndef FASTLANES_FFOR_HPP
 #define FASTLANES_FFOR_HPP
 
+#include "fastlanes/isa.hpp"
 #include <cstdint>
 
 namespace fastlanes::generated::ffor::fallback::scalar {
@@ -16,6 +17,33 @@ void ffor(const int8_t* __restrict in, int8_t* __restrict out, uint8_t bw, const
 
 } // namespace fastlanes::generated::ffor::fallback::scalar
 
-namespace ffor = fastlanes::generated::ffor::fallback::scalar;
+namespace fastlanes::generated::ffor::x86_64::avx2 {
+void ffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void ffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void ffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void ffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::ffor::x86_64::avx2
+
+namespace fastlanes::generated::ffor::x86_64::avx512bw {
+void ffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void ffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void ffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void ffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::ffor::x86_64::avx512bw
+
+//! The kernels of fastlanes::get_isa()
+namespace fastlanes::generated::ffor::dispatch {
+void ffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void ffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void ffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void ffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+
+void ffor(const int64_t* __restrict in, int64_t* __restrict out, uint8_t bw, const int64_t* __restrict a_base_p);
+void ffor(const int32_t* __restrict in, int32_t* __restrict out, uint8_t bw, const int32_t* __restrict a_base_p);
+void ffor(const int16_t* __restrict in, int16_t* __restrict out, uint8_t bw, const int16_t* __restrict a_base_p);
+void ffor(const int8_t* __restrict in, int8_t* __restrict out, uint8_t bw, const int8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::ffor::dispatch
+
+namespace ffor = fastlanes::generated::ffor::dispatch;
 
 #endif
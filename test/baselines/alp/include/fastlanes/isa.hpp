@@ -0,0 +1,45 @@
+#ifndef FASTLANES_ISA_HPP
+#define FASTLANES_ISA_HPP
+
+#include <cstdint>
+
+/*
+ * The generated ffor, unffor and falp kernels are plain C++ laid out for auto-vectorization. On x86_64 the library
+ * compiles them once per instruction set, each copy in its own namespace (FASTLANES_KERNEL_ISA):
+ *
+ *   fallback::scalar   baseline flags
+ *   x86_64::avx2       -mavx2
+ *   x86_64::avx512bw   -mavx512bw -mavx512dq -mavx512vl (DQ converts int64 to double in falp)
+ *
+ * The dispatch namespaces call the widest copy this CPU supports, chosen by cpuid on first use. Every copy keeps
+ * the same 1024-value interleaved layout, so a vector packed by one unpacks with any other.
+ */
+#ifndef FASTLANES_KERNEL_ISA
+#define FASTLANES_KERNEL_ISA fallback::scalar
+#endif
+
+namespace fastlanes {
+
+enum class ISA : uint8_t {
+	FALLBACK = 0,
+	AVX2     = 1,
+	AVX512BW = 2,
+};
+
+//! Whether the kernels of isa are compiled in and this CPU runs them
+bool is_supported(ISA isa);
+
+//! The widest supported ISA
+ISA detect_isa();
+
+//! The ISA the dispatch namespaces call, detect_isa() unless set_isa() overrode it
+ISA get_isa();
+
+//! Overrides the dispatched ISA, e.g. to benchmark one against another; an unsupported isa means detect_isa()
+void set_isa(ISA isa);
+
+const char* isa_name(ISA isa);
+
+} // namespace fastlanes
+
+#endif // FASTLANES_ISA_HPP
@@ -1,6 +1,7 @@
 #ifndef FASTLANES_UNFFOR_HPP
 #define FASTLANES_UNFFOR_HPP
 
+#include "fastlanes/isa.hpp"
 #include <cstdint>
 
 namespace fastlanes { namespace generated { namespace unffor { namespace fallback { namespace scalar {
@@ -15,6 +16,33 @@ void unffor(const int16_t* __restrict in, int16_t* __restrict out, uint8_t bw, c
 void unffor(const int8_t* __restrict in, int8_t* __restrict out, uint8_t bw, const int8_t* __restrict a_base_p);
 }}}}} // namespace fastlanes::generated::unffor::fallback::scalar
 
-namespace unffor = fastlanes::generated::unffor::fallback::scalar;
+namespace fastlanes::generated::unffor::x86_64::avx2 {
+void unffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void unffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void unffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void unffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::unffor::x86_64::avx2
+
+namespace fastlanes::generated::unffor::x86_64::avx512bw {
+void unffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void unffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void unffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void unffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::unffor::x86_64::avx512bw
+
+//! The kernels of fastlanes::get_isa()
+namespace fastlanes::generated::unffor::dispatch {
+void unffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, const uint64_t* __restrict a_base_p);
+void unffor(const uint32_t* __restrict in, uint32_t* __restrict out, uint8_t bw, const uint32_t* __restrict a_base_p);
+void unffor(const uint16_t* __restrict in, uint16_t* __restrict out, uint8_t bw, const uint16_t* __restrict a_base_p);
+void unffor(const uint8_t* __restrict in, uint8_t* __restrict out, uint8_t bw, const uint8_t* __restrict a_base_p);
+
+void unffor(const int64_t* __restrict in, int64_t* __restrict out, uint8_t bw, const int64_t* __restrict a_base_p);
+void unffor(const int32_t* __restrict in, int32_t* __restrict out, uint8_t bw, const int32_t* __restrict a_base_p);
+void unffor(const int16_t* __restrict in, int16_t* __restrict out, uint8_t bw, const int16_t* __restrict a_base_p);
+void unffor(const int8_t* __restrict in, int8_t* __restrict out, uint8_t bw, const int8_t* __restrict a_base_p);
+} // namespace fastlanes::generated::unffor::dispatch
+
+namespace unffor = fastlanes::generated::unffor::dispatch;
 
 #endif
@@ -1,7 +1,8 @@
 #include "alp/falp.hpp"
 #include "alp/constants.hpp"
+#include "fastlanes/isa.hpp"
 
-namespace generated { namespace falp::fallback { namespace scalar {
+namespace generated { namespace falp::FASTLANES_KERNEL_ISA {
 static void falp_0bw_64ow_64crw_1uf(const uint64_t* __restrict a_in_p,
                                     double* __restrict a_out_p,
                                     const uint64_t* __restrict a_base_p,
@@ -16,72 +17,75 @@ static void falp_0bw_64ow_64crw_1uf(const uint64_t* __restrict a_in_p,
 	[[maybe_unused]] double     frac10 = alp::Constants<double>::FRAC_ARR[exp];
 	[[maybe_unused]] double     tmp_dbl;
 	[[maybe_unused]] int64_t    tmp_int;
+	tmp_int = base_0 * factor;
+	tmp_dbl = tmp_int;
+	tmp_dbl *= frac10;
 #pragma clang loop vectorize(enable)
 	for (int i = 0; i < 16; ++i) {
-		*(out + (i * 1) + (0 * 16) + (16 * 0))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 1))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 2))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 3))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 4))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 5))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 6))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 7))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 8))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 9))  = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 10)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 11)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 12)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 13)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 14)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 15)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 16)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 17)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 18)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 19)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 20)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 21)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 22)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 23)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 24)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 25)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 26)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 27)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 28)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 29)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 30)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 31)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 32)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 33)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 34)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 35)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 36)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 37)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 38)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 39)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 40)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 41)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 42)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 43)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 44)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 45)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 46)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 47)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 48)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 49)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 50)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 51)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 52)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 53)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 54)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 55)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 56)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 57)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 58)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 59)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 60)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 61)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 62)) = base_0;
-		*(out + (i * 1) + (0 * 16) + (16 * 63)) = base_0;
+		*(out + (i * 1) + (0 * 16) + (16 * 0))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 1))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 2))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 3))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 4))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 5))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 6))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 7))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 8))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 9))  = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 10)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 11)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 12)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 13)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 14)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 15)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 16)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 17)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 18)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 19)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 20)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 21)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 22)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 23)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 24)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 25)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 26)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 27)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 28)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 29)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 30)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 31)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 32)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 33)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 34)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 35)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 36)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 37)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 38)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 39)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 40)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 41)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 42)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 43)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 44)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 45)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 46)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 47)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 48)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 49)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 50)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 51)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 52)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 53)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 54)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 55)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 56)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 57)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 58)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 59)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 60)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 61)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 62)) = tmp_dbl;
+		*(out + (i * 1) + (0 * 16) + (16 * 63)) = tmp_dbl;
 	}
 }
 static void falp_1bw_64ow_64crw_1uf(const uint64_t* __restrict a_in_p,
@@ -33303,449 +33307,449 @@ static void falp_64bw_64ow_64crw_1uf(const uint64_t* __restrict a_in_p,
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 0)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 0)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 16);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 1)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 1)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 32);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 2)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 2)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 48);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 3)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 3)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 64);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 4)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 4)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 80);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 5)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 5)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 96);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 6)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 6)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 112);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 7)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 7)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 128);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 8)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 8)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 144);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 9)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 9)) = tmp_dbl;
 		register_0                             = *(in + (0 * 16) + (i * 1) + 160);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 10)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 10)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 176);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 11)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 11)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 192);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 12)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 12)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 208);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 13)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 13)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 224);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 14)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 14)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 240);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 15)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 15)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 256);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 16)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 16)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 272);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 17)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 17)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 288);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 18)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 18)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 304);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 19)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 19)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 320);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 20)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 20)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 336);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 21)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 21)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 352);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 22)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 22)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 368);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 23)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 23)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 384);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 24)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 24)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 400);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 25)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 25)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 416);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 26)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 26)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 432);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 27)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 27)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 448);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 28)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 28)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 464);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 29)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 29)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 480);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 30)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 30)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 496);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 31)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 31)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 512);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 32)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 32)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 528);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 33)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 33)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 544);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 34)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 34)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 560);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 35)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 35)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 576);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 36)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 36)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 592);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 37)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 37)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 608);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 38)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 38)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 624);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 39)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 39)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 640);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 40)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 40)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 656);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 41)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 41)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 672);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 42)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 42)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 688);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 43)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 43)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 704);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 44)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 44)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 720);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 45)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 45)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 736);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 46)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 46)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 752);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 47)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 47)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 768);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 48)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 48)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 784);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 49)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 49)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 800);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 50)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 50)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 816);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 51)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 51)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 832);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 52)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 52)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 848);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 53)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 53)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 864);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 54)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 54)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 880);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 55)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 55)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 896);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 56)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 56)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 912);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 57)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 57)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 928);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 58)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 58)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 944);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 59)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 59)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 960);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 60)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 60)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 976);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 61)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 61)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 992);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 62)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 62)) = tmp_dbl;
 		register_0                              = *(in + (0 * 16) + (i * 1) + 1008);
 		register_0 += base_0;
 		register_0 *= factor;
 		tmp_int = register_0;
 		tmp_dbl = tmp_int;
-		register_0 *= frac10;
-		*(out + (i * 1) + (0 * 16) + (16 * 63)) = register_0;
+		tmp_dbl *= frac10;
+		*(out + (i * 1) + (0 * 16) + (16 * 63)) = tmp_dbl;
 	}
 }
 void falp(const uint64_t* __restrict a_in_p,
@@ -33952,4 +33956,4 @@ void falp(const uint64_t* __restrict a_in_p,
 		break;
 	}
 }
-}}}; // namespace generated::falp::fallback::scalar
+}} // namespace generated::falp::FASTLANES_KERNEL_ISA
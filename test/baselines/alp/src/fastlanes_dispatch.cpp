@@ -0,0 +1,102 @@
+#include "alp/falp.hpp"
+#include "fastlanes/ffor.hpp"
+#include "fastlanes/unffor.hpp"
+#include <atomic>
+
+namespace fastlanes {
+
+bool is_supported(ISA isa) {
+	switch (isa) {
+	case ISA::FALLBACK:
+		return true;
+#ifdef ALP_X86_64_KERNELS
+	case ISA::AVX2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+	case ISA::AVX512BW:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+		       __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+#endif
+	default:
+		return false;
+	}
+}
+
+ISA detect_isa() {
+	if (is_supported(ISA::AVX512BW)) { return ISA::AVX512BW; }
+	if (is_supported(ISA::AVX2)) { return ISA::AVX2; }
+	return ISA::FALLBACK;
+}
+
+static std::atomic<ISA>& active_isa() {
+	static std::atomic<ISA> isa {detect_isa()};
+	return isa;
+}
+
+ISA get_isa() { return active_isa().load(std::memory_order_relaxed); }
+
+void set_isa(ISA isa) {
+	if (!is_supported(isa)) { isa = detect_isa(); }
+	active_isa().store(isa, std::memory_order_relaxed);
+}
+
+const char* isa_name(ISA isa) {
+	switch (isa) {
+	case ISA::AVX2:
+		return "avx2";
+	case ISA::AVX512BW:
+		return "avx512bw";
+	default:
+		return "fallback";
+	}
+}
+
+} // namespace fastlanes
+
+#ifdef ALP_X86_64_KERNELS
+#define FASTLANES_DISPATCH(NS, KERNEL, ...)                                                                           \
+	switch (fastlanes::get_isa()) {                                                                                    \
+	case fastlanes::ISA::AVX512BW:                                                                                     \
+		return NS::x86_64::avx512bw::KERNEL(__VA_ARGS__);                                                              \
+	case fastlanes::ISA::AVX2:                                                                                         \
+		return NS::x86_64::avx2::KERNEL(__VA_ARGS__);                                                                  \
+	default:                                                                                                           \
+		return NS::fallback::scalar::KERNEL(__VA_ARGS__);                                                              \
+	}
+#else
+#define FASTLANES_DISPATCH(NS, KERNEL, ...) return NS::fallback::scalar::KERNEL(__VA_ARGS__);
+#endif
+
+#define FASTLANES_DISPATCH_PACKING(KERNEL, UT, ST)                                                                     \
+	void KERNEL(const UT* __restrict in, UT* __restrict out, uint8_t bw, const UT* __restrict a_base_p) {              \
+		FASTLANES_DISPATCH(::fastlanes::generated::KERNEL, KERNEL, in, out, bw, a_base_p)                                \
+	}                                                                                                                  \
+	void KERNEL(const ST* __restrict in, ST* __restrict out, uint8_t bw, const ST* __restrict a_base_p) {              \
+		KERNEL(reinterpret_cast<const UT*>(in), reinterpret_cast<UT*>(out), bw, reinterpret_cast<const UT*>(a_base_p)); \
+	}
+
+namespace fastlanes::generated::ffor::dispatch {
+FASTLANES_DISPATCH_PACKING(ffor, uint64_t, int64_t)
+FASTLANES_DISPATCH_PACKING(ffor, uint32_t, int32_t)
+FASTLANES_DISPATCH_PACKING(ffor, uint16_t, int16_t)
+FASTLANES_DISPATCH_PACKING(ffor, uint8_t, int8_t)
+} // namespace fastlanes::generated::ffor::dispatch
+
+namespace fastlanes::generated::unffor::dispatch {
+FASTLANES_DISPATCH_PACKING(unffor, uint64_t, int64_t)
+FASTLANES_DISPATCH_PACKING(unffor, uint32_t, int32_t)
+FASTLANES_DISPATCH_PACKING(unffor, uint16_t, int16_t)
+FASTLANES_DISPATCH_PACKING(unffor, uint8_t, int8_t)
+} // namespace fastlanes::generated::unffor::dispatch
+
+namespace generated::falp::dispatch {
+void falp(const uint64_t* __restrict in,
+          double* __restrict out,
+          uint8_t bw,
+          const uint64_t* __restrict a_base_p,
+          uint8_t factor,
+          uint8_t exponent) {
+	FASTLANES_DISPATCH(::generated::falp, falp, in, out, bw, a_base_p, factor, exponent)
+}
+} // namespace generated::falp::dispatch
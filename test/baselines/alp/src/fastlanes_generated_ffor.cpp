@@ -1,6 +1,6 @@
 #include "fastlanes/ffor.hpp"
 #include "fastlanes/macros.hpp"
-namespace fastlanes { namespace generated { namespace ffor::fallback { namespace scalar {
+namespace fastlanes { namespace generated { namespace ffor::FASTLANES_KERNEL_ISA {
 void static ffor_0bit_8ow(const uint8_t* __restrict in, uint8_t* __restrict out, const uint8_t* __restrict a_base_p) {}
 void static ffor_1bit_8ow(const uint8_t* __restrict in, uint8_t* __restrict out, const uint8_t* __restrict a_base_p) {
 	uint8_t tmp = 0U;
@@ -30135,4 +30135,4 @@ void ffor(const uint64_t* __restrict in, uint64_t* __restrict out, uint8_t bw, c
 		return;
 	}
 }
-}}}} // namespace fastlanes::generated::ffor::fallback::scalar
+}}} // namespace fastlanes::generated::ffor::FASTLANES_KERNEL_ISA
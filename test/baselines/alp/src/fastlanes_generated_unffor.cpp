@@ -1,6 +1,6 @@
 #include "fastlanes/unffor.hpp"
 
-namespace fastlanes { namespace generated { namespace unffor::fallback { namespace scalar {
+namespace fastlanes { namespace generated { namespace unffor::FASTLANES_KERNEL_ISA {
 static void unffor_0bw_8ow_8crw_1uf(const uint8_t* __restrict a_in_p,
                                     uint8_t* __restrict a_out_p,
                                     const uint8_t* __restrict a_base_p) {
@@ -23209,4 +23209,4 @@ void unffor(const uint64_t* __restrict a_in_p,
 		break;
 	}
 }
-}}}} // namespace fastlanes::generated::unffor::fallback::scalar
+}}} // namespace fastlanes::generated::unffor::FASTLANES_KERNEL_ISA
@@ -0,0 +1,104 @@
+#ifndef BITSTREAM_BIT_READER_H
+#define BITSTREAM_BIT_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "bit_writer.h"
+
+namespace bitstream {
+
+BITSTREAM_INLINE uint64_t LoadBigEndian64(const uint8_t *src) {
+    uint64_t word;
+    std::memcpy(&word, src, sizeof(uint64_t));
+    return __builtin_bswap64(word);
+}
+
+// MSB-first bit reader over a caller buffer. The reader only keeps a bit
+// position: a peek is one unaligned 64-bit load at the current byte, shifted by
+// the bit offset, so there is no refill state to maintain and reads of up to 56
+// bits never split. Bits past the end of the buffer read as zero.
+class BitReader {
+public:
+    BitReader() = default;
+
+    BitReader(const uint8_t *data, size_t size) {
+        Reset(data, size);
+    }
+
+    void Reset(const uint8_t *data, size_t size) {
+        data_ = data;
+        size_ = size;
+        pos_ = 0;
+    }
+
+    // The next len bits without consuming them, 0 <= len <= 57
+    BITSTREAM_INLINE uint64_t Peek(uint32_t len) const {
+        uint64_t word = Load(pos_ >> 3) << (pos_ & 7);
+        // Two shifts keep len == 0 defined
+        return (word >> 1) >> (63 - len);
+    }
+
+    BITSTREAM_INLINE void Forward(uint32_t len) {
+        pos_ += len;
+    }
+
+    // 0 <= len <= 64
+    BITSTREAM_INLINE uint64_t Read(uint32_t len) {
+        if (__builtin_expect(len > 56, 0)) {
+            uint64_t high = Peek(32);
+            pos_ += 32;
+            len -= 32;
+            uint64_t low = Peek(len);
+            pos_ += len;
+            return (high << len) | low;
+        }
+        uint64_t value = Peek(len);
+        pos_ += len;
+        return value;
+    }
+
+    template<uint32_t kLen>
+    BITSTREAM_INLINE uint64_t Read() {
+        static_assert(kLen <= 64, "bit width out of range");
+        if constexpr (kLen > 56) {
+            return Read(kLen);
+        } else {
+            uint64_t value = Peek(kLen);
+            pos_ += kLen;
+            return value;
+        }
+    }
+
+    BITSTREAM_INLINE uint32_t ReadBit() {
+        return static_cast<uint32_t>(Read<1>());
+    }
+
+    size_t BitsRead() const {
+        return pos_;
+    }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    // Bits consumed
+    size_t pos_ = 0;
+
+    BITSTREAM_INLINE uint64_t Load(size_t byte) const {
+        if (__builtin_expect(byte + 8 <= size_, 1)) return LoadBigEndian64(data_ + byte);
+        return LoadTail(byte);
+    }
+
+    uint64_t LoadTail(size_t byte) const {
+        uint64_t word = 0;
+        for (int k = 0; k < 8 && byte + k < size_; ++k) {
+            word |= static_cast<uint64_t>(data_[byte + k]) << (56 - 8 * k);
+        }
+        return word;
+    }
+};
+
+}  // namespace bitstream
+
+#endif  // BITSTREAM_BIT_READER_H
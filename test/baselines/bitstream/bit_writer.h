@@ -0,0 +1,144 @@
+#ifndef BITSTREAM_BIT_WRITER_H
+#define BITSTREAM_BIT_WRITER_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#define BITSTREAM_INLINE [[gnu::always_inline]] inline
+
+namespace bitstream {
+
+BITSTREAM_INLINE void StoreBigEndian64(uint8_t *dst, uint64_t word) {
+    word = __builtin_bswap64(word);
+    std::memcpy(dst, &word, sizeof(uint64_t));
+}
+
+// MSB-first bit writer. Bits collect in a 64-bit accumulator that is stored
+// with a single unaligned big-endian store once full, so the byte stream is the
+// same as the one produced by the former 32-bit word streams.
+//
+// The writer either fills a caller buffer of fixed capacity or owns a buffer
+// that grows on demand; only the store path checks the capacity.
+class BitWriter {
+public:
+    // Owned, growable buffer
+    explicit BitWriter(size_t capacity = 64) : owned_(capacity), owns_(true) {
+        out_ = owned_.data();
+        capacity_ = owned_.size();
+    }
+
+    // Caller buffer of capacity bytes
+    BitWriter(uint8_t *out, size_t capacity) {
+        Reset(out, capacity);
+    }
+
+    BitWriter(const BitWriter &) = delete;
+    BitWriter &operator=(const BitWriter &) = delete;
+
+    void Reset(uint8_t *out, size_t capacity) {
+        owns_ = false;
+        out_ = out;
+        capacity_ = capacity;
+        Rewind();
+    }
+
+    // Starts over at the beginning of the current buffer
+    void Rewind() {
+        pos_ = 0;
+        acc_ = 0;
+        filled_ = 0;
+    }
+
+    // Grows an owned buffer to at least capacity bytes
+    void Reserve(size_t capacity) {
+        assert(owns_);
+        if (capacity <= owned_.size()) return;
+        owned_.resize(capacity);
+        out_ = owned_.data();
+        capacity_ = owned_.size();
+    }
+
+    // Writes the low len bits of value, 0 <= len <= 64
+    BITSTREAM_INLINE uint32_t Write(uint64_t value, uint32_t len) {
+        if (len == 0) return 0;
+        uint64_t aligned = value << (64 - len);
+        acc_ |= aligned >> filled_;
+        uint32_t filled = filled_ + len;
+        if (filled >= 64) {
+            Store(acc_);
+            // The bits of value that did not fit, if any
+            acc_ = filled_ == 0 ? 0 : aligned << (64 - filled_);
+            filled -= 64;
+        }
+        filled_ = filled;
+        return len;
+    }
+
+    template<uint32_t kLen>
+    BITSTREAM_INLINE uint32_t Write(uint64_t value) {
+        static_assert(kLen > 0 && kLen <= 64, "bit width out of range");
+        return Write(value, kLen);
+    }
+
+    BITSTREAM_INLINE uint32_t WriteBit(bool bit) {
+        return Write(static_cast<uint64_t>(bit), 1);
+    }
+
+    // Stores the pending bits, zero padded to a byte, and returns the number of
+    // bytes written so far. Further writes start at the next byte.
+    size_t Flush() {
+        if (filled_ != 0) {
+            size_t bytes = (filled_ + 7) / 8;
+            EnsureCapacity(bytes);
+            uint64_t word = __builtin_bswap64(acc_);
+            std::memcpy(out_ + pos_, &word, bytes);
+            pos_ += bytes;
+            acc_ = 0;
+            filled_ = 0;
+        }
+        return pos_;
+    }
+
+    size_t BitsWritten() const {
+        return pos_ * 8 + filled_;
+    }
+
+    uint8_t *data() const {
+        return out_;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    std::vector<uint8_t> owned_;
+    bool owns_ = false;
+    uint8_t *out_ = nullptr;
+    size_t capacity_ = 0;
+    // Bytes stored
+    size_t pos_ = 0;
+    // Pending bits, left aligned
+    uint64_t acc_ = 0;
+    uint32_t filled_ = 0;
+
+    BITSTREAM_INLINE void Store(uint64_t word) {
+        if (__builtin_expect(pos_ + 8 > capacity_, 0)) EnsureCapacity(8);
+        StoreBigEndian64(out_ + pos_, word);
+        pos_ += 8;
+    }
+
+    void EnsureCapacity(size_t bytes) {
+        if (pos_ + bytes <= capacity_) return;
+        if (!owns_) throw std::length_error("[BitStream Error]: Output buffer is full");
+        Reserve(2 * (pos_ + bytes));
+    }
+};
+
+}  // namespace bitstream
+
+#endif  // BITSTREAM_BIT_WRITER_H
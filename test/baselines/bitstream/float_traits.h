@@ -0,0 +1,86 @@
+#ifndef BITSTREAM_FLOAT_TRAITS_H
+#define BITSTREAM_FLOAT_TRAITS_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "bit_writer.h"
+
+namespace bitstream {
+
+// The IEEE 754 layout of a value type, for the codecs that work on the bits
+// of a value (Gorilla, Chimp): the unsigned integer holding them, their width
+// and the field widths derived from it.
+template<typename T>
+struct FloatTraits;
+
+template<>
+struct FloatTraits<double> {
+    using Bits = uint64_t;
+
+    static constexpr int kBits = 64;
+
+    // Width of a field holding a bit count in [1, kBits], kBits stored as 0
+    static constexpr int kBitsLog2 = 6;
+
+    static constexpr int kMantissaBits = 52;
+
+    static constexpr int kExponentBits = 11;
+
+    BITSTREAM_INLINE static Bits ToBits(double value) {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    BITSTREAM_INLINE static double FromBits(Bits bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    BITSTREAM_INLINE static int Clz(Bits bits) {
+        return __builtin_clzll(bits);
+    }
+
+    BITSTREAM_INLINE static int Ctz(Bits bits) {
+        return __builtin_ctzll(bits);
+    }
+};
+
+template<>
+struct FloatTraits<float> {
+    using Bits = uint32_t;
+
+    static constexpr int kBits = 32;
+
+    static constexpr int kBitsLog2 = 5;
+
+    static constexpr int kMantissaBits = 23;
+
+    static constexpr int kExponentBits = 8;
+
+    BITSTREAM_INLINE static Bits ToBits(float value) {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    BITSTREAM_INLINE static float FromBits(Bits bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    BITSTREAM_INLINE static int Clz(Bits bits) {
+        return __builtin_clz(bits);
+    }
+
+    BITSTREAM_INLINE static int Ctz(Bits bits) {
+        return __builtin_ctz(bits);
+    }
+};
+
+}  // namespace bitstream
+
+#endif  // BITSTREAM_FLOAT_TRAITS_H
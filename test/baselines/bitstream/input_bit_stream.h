@@ -0,0 +1,58 @@
+#ifndef SERF_INPUT_BIT_STREAM_H
+#define SERF_INPUT_BIT_STREAM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "array.h"
+#include "bit_reader.h"
+
+// The input stream shared by the XOR and fixed-point codecs, on top of
+// bitstream::BitReader. It keeps its own copy of the compressed bytes.
+class InputBitStream {
+ public:
+    InputBitStream() = default;
+
+    InputBitStream(uint8_t *raw_data, size_t size) {
+        SetBuffer(raw_data, size);
+    }
+
+    InputBitStream(const InputBitStream &) = delete;
+    InputBitStream &operator=(const InputBitStream &) = delete;
+
+    BITSTREAM_INLINE uint64_t ReadLong(size_t len) {
+        return reader_.Read(static_cast<uint32_t>(len));
+    }
+
+    BITSTREAM_INLINE uint32_t ReadInt(size_t len) {
+        return static_cast<uint32_t>(reader_.Read(static_cast<uint32_t>(len)));
+    }
+
+    BITSTREAM_INLINE uint32_t ReadBit() {
+        return reader_.ReadBit();
+    }
+
+    void SetBuffer(const Array<uint8_t> &new_buffer) {
+        SetBuffer(new_buffer.begin(), new_buffer.length());
+    }
+
+    void SetBuffer(const std::vector<uint8_t> &new_buffer) {
+        SetBuffer(new_buffer.data(), new_buffer.size());
+    }
+
+    void SetBuffer(const uint8_t *raw_data, size_t size) {
+        data_.assign(raw_data, raw_data + size);
+        reader_.Reset(data_.data(), data_.size());
+    }
+
+ private:
+    std::vector<uint8_t> data_;
+    bitstream::BitReader reader_;
+};
+
+#endif  // SERF_INPUT_BIT_STREAM_H
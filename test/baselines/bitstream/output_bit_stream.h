@@ -0,0 +1,58 @@
+#ifndef SERF_OUTPUT_BIT_STREAM_H
+#define SERF_OUTPUT_BIT_STREAM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "array.h"
+#include "bit_writer.h"
+
+// The output stream shared by the XOR and fixed-point codecs, on top of
+// bitstream::BitWriter
+class OutputBitStream {
+ public:
+    explicit OutputBitStream(uint32_t buffer_size) : writer_(buffer_size + 8) {}
+
+    BITSTREAM_INLINE uint32_t Write(uint64_t content, uint32_t len) {
+        return writer_.Write(content, len);
+    }
+
+    BITSTREAM_INLINE uint32_t WriteLong(uint64_t content, uint64_t len) {
+        return writer_.Write(content, static_cast<uint32_t>(len));
+    }
+
+    BITSTREAM_INLINE uint32_t WriteInt(uint32_t content, uint32_t len) {
+        return writer_.Write(content, len);
+    }
+
+    BITSTREAM_INLINE uint32_t WriteBit(bool bit) {
+        return writer_.WriteBit(bit);
+    }
+
+    void Flush() {
+        writer_.Flush();
+    }
+
+    Array<uint8_t> GetBuffer(uint32_t len) {
+        Array<uint8_t> ret(len);
+        size_t copied = std::min<size_t>(len, writer_.capacity());
+        std::memcpy(ret.begin(), writer_.data(), copied);
+        std::memset(ret.begin() + copied, 0, len - copied);
+        return ret;
+    }
+
+    void Refresh() {
+        writer_.Rewind();
+    }
+
+    // Grows the buffer to buffer_size bytes, keeping what was written so far
+    void Reserve(uint32_t buffer_size) {
+        writer_.Reserve(buffer_size + 8);
+    }
+
+ private:
+    bitstream::BitWriter writer_;
+};
+
+#endif  // SERF_OUTPUT_BIT_STREAM_H
@@ -0,0 +1,103 @@
+#ifndef BITSTREAM_STREAM_HEADER_H
+#define BITSTREAM_STREAM_HEADER_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace bitstream {
+
+// Byte-aligned header in front of a Gorilla/Chimp bit stream. It carries the
+// value count, so decoders can size their output and stop without an end
+// marker, and optionally the first/last/min/max of the block.
+//
+//   [version:1][flags:1][count:4 LE]([first][last][min][max]: 8 LE each)
+//
+// Encoders reserve size() bytes at the start of the stream and store the
+// header over them once the block is closed.
+struct StreamHeader {
+    static constexpr uint8_t kVersion = 1;
+
+    static constexpr uint8_t kFlagStats = 0x1;
+
+    static constexpr size_t kBaseSize = 6;
+
+    static constexpr size_t kStatsSize = 4 * sizeof(double);
+
+    uint8_t version = kVersion;
+
+    uint8_t flags = 0;
+
+    uint32_t count = 0;
+
+    double first = 0;
+
+    double last = 0;
+
+    // NaNs are left out of min/max
+    double min = std::numeric_limits<double>::infinity();
+
+    double max = -std::numeric_limits<double>::infinity();
+
+    explicit StreamHeader(bool with_stats = false) : flags(with_stats ? kFlagStats : 0) {}
+
+    bool has_stats() const {
+        return flags & kFlagStats;
+    }
+
+    size_t size() const {
+        return has_stats() ? kBaseSize + kStatsSize : kBaseSize;
+    }
+
+    // Counts a value and updates the statistics if they are kept
+    void Add(double v) {
+        if (has_stats()) {
+            if (count == 0) first = v;
+            last = v;
+            min = std::fmin(min, v);
+            max = std::fmax(max, v);
+        }
+        ++count;
+    }
+
+    // Starts a new block with the same flags
+    void Clear() {
+        *this = StreamHeader(has_stats());
+    }
+
+    void Store(uint8_t *dst) const {
+        dst[0] = version;
+        dst[1] = flags;
+        std::memcpy(dst + 2, &count, sizeof(count));
+        if (has_stats()) {
+            double stats[4] = {first, last, min, max};
+            std::memcpy(dst + kBaseSize, stats, kStatsSize);
+        }
+    }
+
+    static StreamHeader Load(const uint8_t *src, size_t size) {
+        if (size < kBaseSize) throw std::runtime_error("[StreamHeader Error]: Stream is too short");
+        StreamHeader header;
+        header.version = src[0];
+        header.flags = src[1];
+        if (header.version != kVersion) throw std::runtime_error("[StreamHeader Error]: Unknown stream version");
+        std::memcpy(&header.count, src + 2, sizeof(header.count));
+        if (header.has_stats()) {
+            if (size < kBaseSize + kStatsSize) throw std::runtime_error("[StreamHeader Error]: Stream is too short");
+            double stats[4];
+            std::memcpy(stats, src + kBaseSize, kStatsSize);
+            header.first = stats[0];
+            header.last = stats[1];
+            header.min = stats[2];
+            header.max = stats[3];
+        }
+        return header;
+    }
+};
+
+}  // namespace bitstream
+
+#endif  // BITSTREAM_STREAM_HEADER_H
@@ -1,32 +1,42 @@
 #include "buff_compressor.h"
 
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#include "prefilter.h"
+
 BuffCompressor::BuffCompressor(int batch_size, int max_prec) {
+    if (max_prec < 0 || max_prec >= static_cast<int>(std::size(precision_map_))) {
+        throw std::invalid_argument("[BUFF Error]: Precision out of range");
+    }
     batch_size_ = batch_size;
     max_prec_ = max_prec;
-    output_bit_stream_ = std::make_unique<OutputBitStream>(10000);
+    output_bit_stream_ = std::make_unique<OutputBitStream>(2 * batch_size * sizeof(double) + 64);
     size_ = 0;
 }
 
 int BuffCompressor::getWidthNeeded(uint64_t number) {
     if (number == 0) return 0;
-    int bit_count = 0;
-    while (number > 0) {
-        bit_count++;
-        number = number >> 1;
-    }
-    return bit_count;
+    return 64 - __builtin_clzll(number);
 }
 
-SparseResult BuffCompressor::findMajority(Array<uint8_t> nums) {
-    SparseResult result(batch_size_);
+int BuffCompressor::getPackWidth(int column_count) {
+    if (column_count <= 2) return 2;
+    if (column_count <= 4) return 4;
+    return 8;
+}
+
+SparseResult BuffCompressor::findMajority(const uint8_t *col, int length) {
+    SparseResult result;
     uint8_t candidate = 0;
     int count = 0;
 
-    for (const auto &num: nums) {
+    for (int i = 0; i < length; ++i) {
         if (count == 0) {
-            candidate = num;
+            candidate = col[i];
             count = 1;
-        } else if (num == candidate) {
+        } else if (col[i] == candidate) {
             count++;
         } else {
             count--;
@@ -34,22 +44,10 @@ SparseResult BuffCompressor::findMajority(Array<uint8_t> nums) {
     }
 
     count = 0;
-    for (int i = 0; i < nums.length(); ++i) {
-        int index = i / 8;
-        result.bitmap_[index] = (uint8_t) (result.bitmap_[index] << 1);
-        if (nums[i] == candidate) {
-            count++;
-        } else {
-            result.bitmap_[index] = (uint8_t) (result.bitmap_[index] | 0b1);
-            result.outliers_[result.outliers_count_++] = nums[i];
-        }
-        if (i + 1 == nums.length() && (i + 1) % 8 != 0) {
-            // Here this line of code differs from that in Java
-            result.bitmap_[index] = (uint8_t) (result.bitmap_[index] << (i % 8 + 1));
-        }
-    }
+    for (int i = 0; i < length; ++i) count += (col[i] == candidate);
 
-    if (count >= nums.length() * 0.9) {
+    result.outliers_count_ = length - count;
+    if (count >= length * 0.9) {
         result.flag_ = true;
         result.frequent_value_ = candidate;
     } else {
@@ -63,10 +61,9 @@ Array<uint8_t> BuffCompressor::get_out() {
     return out;
 }
 
-void BuffCompressor::wholeWidthLongCompress(Array<double> values) {
-    for (const auto &value: values) {
-        size_ += output_bit_stream_->WriteLong(Double::DoubleToLongBits(value),
-                                               64);
+void BuffCompressor::wholeWidthLongCompress(const double *values, int length) {
+    for (int i = 0; i < length; ++i) {
+        size_ += output_bit_stream_->WriteLong(Double::DoubleToLongBits(values[i]), 64);
     }
 }
 
@@ -78,26 +75,26 @@ long BuffCompressor::get_size() {
     return size_;
 }
 
-void BuffCompressor::compress(const Array<double> &values) {
-    headSample(values);
-    Array<Array<uint8_t>> cols = encode(values);
+void BuffCompressor::compress(const double *values, int length) {
+    batch_size_ = length;
+    headSample(values, length);
     size_ += output_bit_stream_->WriteLong(lower_bound_, 64);
     size_ += output_bit_stream_->WriteInt(batch_size_, 32);
     size_ += output_bit_stream_->WriteInt(max_prec_, 32);
     size_ += output_bit_stream_->WriteInt(int_width_, 32);
     if (whole_width_ >= 64) {
-        wholeWidthLongCompress(values);
+        wholeWidthLongCompress(values, length);
     } else {
-        sparseEncode(cols);
+        sparseEncode(encode(values, length));
     }
     close();
 }
 
-void BuffCompressor::headSample(const Array<double> &dbs) {
+void BuffCompressor::headSample(const double *dbs, int length) {
     lower_bound_ = std::numeric_limits<long>::max();
     long upper_bound = std::numeric_limits<long>::min();
-    for (const auto &db: dbs) {
-        uint64_t bits = Double::DoubleToLongBits(db);
+    for (int i = 0; i < length; ++i) {
+        uint64_t bits = Double::DoubleToLongBits(dbs[i]);
         uint64_t sign = bits >> 63;
         int64_t exp = (int64_t) (bits >> 52 & 0x7FF) - 1023;
         uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFL;
@@ -121,14 +118,18 @@ void BuffCompressor::headSample(const Array<double> &dbs) {
     }
 }
 
-Array<Array<uint8_t>> BuffCompressor::encode(const Array<double> &dbs) {
-    Array<Array<uint8_t>> cols(column_count_);
-    for (auto &col: cols) {
-        col = Array<uint8_t>(dbs.length());
-    }
-    int db_cnt = 0;
-    for (const auto &db: dbs) {
-        uint64_t bits = Double::DoubleToLongBits(db);
+const uint8_t *BuffCompressor::encode(const double *dbs, int length) {
+    // Every value is packed into pack_width bytes with the partial column in
+    // the lowest byte, so byte k of the packed values is column
+    // column_count_ - 1 - k and one byte transpose yields all the columns.
+    int pack_width = getPackWidth(column_count_);
+    size_t total = static_cast<size_t>(length) * pack_width;
+    if (packed_.size() < total) packed_.resize(total);
+    if (cols_.size() < total) cols_.resize(total);
+
+    int remain = whole_width_ % 8;
+    for (int i = 0; i < length; ++i) {
+        uint64_t bits = Double::DoubleToLongBits(dbs[i]);
         uint64_t sign = bits >> 63;
         int64_t exp = (int64_t) (bits >> 52 & 0x7FF) - 1023;
         uint64_t mantissa = bits & 0x000FFFFFFFFFFFFFL;
@@ -147,47 +148,49 @@ Array<Array<uint8_t>> BuffCompressor::encode(const Array<double> &dbs) {
         int64_t integer_value = (sign == 0) ? integer : -integer;
         int64_t offset = integer_value - lower_bound_;
         uint64_t bit_pack = sign << (whole_width_ - 1) | (offset << dec_width_) | decimal;
-        int remain = whole_width_ % 8;
-        int bytes_count = 0;
         if (remain != 0) {
-            bytes_count++;
-            cols[column_count_ - bytes_count][db_cnt] = (uint8_t) (bit_pack & last_mask_[remain - 1]);
-            bit_pack = bit_pack >> remain;
-        }
-        while (bytes_count < column_count_) {
-            bytes_count++;
-            cols[column_count_ - bytes_count][db_cnt] = (uint8_t) (bit_pack & last_mask_[7]);
-            bit_pack = bit_pack >> 8;
+            bit_pack = (bit_pack >> remain << 8) | (bit_pack & last_mask_[remain - 1]);
         }
-
-        db_cnt++;
+        std::memcpy(packed_.data() + static_cast<size_t>(i) * pack_width, &bit_pack, pack_width);
     }
-    return cols;
+
+    Prefilter::ByteShuffle(packed_.data(), cols_.data(), length, pack_width);
+    return cols_.data();
 }
 
-void BuffCompressor::sparseEncode(Array<Array<uint8_t>> &cols) {
+void BuffCompressor::sparseEncode(const uint8_t *cols) {
     for (int i = 0; i < column_count_; ++i) {
-        SparseResult result = findMajority(cols[i]);
+        const uint8_t *col = cols + static_cast<size_t>(column_count_ - 1 - i) * batch_size_;
+        SparseResult result = findMajority(col, batch_size_);
         if (result.flag_) {
             size_ += output_bit_stream_->WriteBit(true);
-            serialize(result);
+            serialize(col, result);
         } else {
             size_ += output_bit_stream_->WriteBit(false);
             for (int j = 0; j < batch_size_; ++j) {
-                size_ += output_bit_stream_->WriteInt(cols[i][j], 8);
+                size_ += output_bit_stream_->WriteInt(col[j], 8);
             }
         }
     }
 }
 
-void BuffCompressor::serialize(SparseResult sr) {
+void BuffCompressor::serialize(const uint8_t *col, const SparseResult &sr) {
     size_ += output_bit_stream_->WriteInt(sr.frequent_value_, 8);
-    for (int i = 0; i < batch_size_ / 8; ++i) {
-        size_ += output_bit_stream_->WriteInt(sr.bitmap_[i], 8);
+    // One bit per value, most significant bit first, set for outliers
+    int j = 0;
+    for (; j + 8 <= batch_size_; j += 8) {
+        uint32_t bitmap = 0;
+        for (int k = 0; k < 8; ++k) bitmap = (bitmap << 1) | (col[j + k] != sr.frequent_value_);
+        size_ += output_bit_stream_->WriteInt(bitmap, 8);
     }
-    size_ += output_bit_stream_->WriteInt(sr.bitmap_[batch_size_ / 8],
-                                          batch_size_ % 8);
-    for (int i = 0; i < sr.outliers_count_; ++i) {
-        size_ += output_bit_stream_->WriteInt(sr.outliers_[i], 8);
+    if (j < batch_size_) {
+        uint32_t bitmap = 0;
+        for (; j < batch_size_; ++j) bitmap = (bitmap << 1) | (col[j] != sr.frequent_value_);
+        size_ += output_bit_stream_->WriteInt(bitmap, batch_size_ % 8);
+    }
+    for (j = 0; j < batch_size_; ++j) {
+        if (col[j] != sr.frequent_value_) {
+            size_ += output_bit_stream_->WriteInt(col[j], 8);
+        }
     }
 }
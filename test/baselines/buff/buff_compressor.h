@@ -3,9 +3,6 @@
 
 
 #include <memory>
-#include <string>
-#include <sstream>
-#include <iomanip>
 #include <cmath>
 #include <vector>
 
@@ -18,16 +15,21 @@ class BuffCompressor {
 public:
     explicit BuffCompressor(int batch_size, int max_prec);
     static int getWidthNeeded(uint64_t number);
-    SparseResult findMajority(Array<uint8_t> nums);
+    // Width in bytes of the transposed values: 2, 4 or 8
+    static int getPackWidth(int column_count);
+    SparseResult findMajority(const uint8_t *col, int length);
     Array<uint8_t> get_out();
-    void compress(const Array<double> &values);
-    void wholeWidthLongCompress(Array<double> values);
+    void compress(const double *values, int length);
+    void wholeWidthLongCompress(const double *values, int length);
     void close();
     long get_size();
-    void headSample(const Array<double> &dbs);
-    Array<Array<uint8_t>> encode(const Array<double> &dbs);
-    void sparseEncode(Array<Array<uint8_t>> &cols);
-    void serialize(SparseResult sr);
+    void headSample(const double *dbs, int length);
+    // Splits the fixed-point values into column_count_ byte columns stored back
+    // to back, the most significant column last. Column i starts at
+    // (column_count_ - 1 - i) * length.
+    const uint8_t *encode(const double *dbs, int length);
+    void sparseEncode(const uint8_t *cols);
+    void serialize(const uint8_t *col, const SparseResult &sr);
 
 private:
     static constexpr int precision_map_[] = {0, 5, 8, 11, 15, 18, 21, 25, 28, 31, 35, 38, 50, 52, 52, 52, 64, 64, 64,
@@ -42,6 +44,8 @@ private:
     int int_width_;
     int whole_width_;
     int column_count_;
+    std::vector<uint8_t> packed_;
+    std::vector<uint8_t> cols_;
 };
 
 
@@ -1,136 +1,149 @@
-#include <sstream>
-#include <iomanip>
-#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
 #include "buff_decompressor.h"
+#include "buff_compressor.h"
+#include "prefilter.h"
+
+namespace {
+
+constexpr double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+                                   1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+}  // namespace
 
-BuffDecompressor::BuffDecompressor(Array<uint8_t> bs) {
+BuffDecompressor::BuffDecompressor(const Array<uint8_t> &bs) {
     input_bit_stream_ = std::make_unique<InputBitStream>();
     input_bit_stream_->SetBuffer(bs);
 }
 
 int BuffDecompressor::getWidthNeeded(uint64_t number) {
     if (number == 0) return 0;
-    int bit_count = 0;
-    while (number > 0) {
-        bit_count++;
-        number = number >> 1;
-    }
-    return bit_count;
+    return 64 - __builtin_clzll(number);
 }
 
 Array<double> BuffDecompressor::decompress() {
+    readHeader();
+    Array<double> result(batch_size_);
+    decodeBody(result.begin());
+    return result;
+}
+
+int BuffDecompressor::decompress(double *output) {
+    readHeader();
+    decodeBody(output);
+    return batch_size_;
+}
+
+void BuffDecompressor::readHeader() {
     lower_bound_ = input_bit_stream_->ReadLong(64);
     batch_size_ = input_bit_stream_->ReadInt(32);
     max_prec_ = input_bit_stream_->ReadInt(32);
+    // Indexes both tables here and BuffQuery's powers of ten
+    static_assert(std::size(precision_map_) == std::size(kPowersOfTen));
+    if (max_prec_ < 0 || max_prec_ >= static_cast<int>(std::size(precision_map_))) {
+        throw std::runtime_error("[BUFF Error]: Precision out of range");
+    }
     int_width_ = input_bit_stream_->ReadInt(32);
     dec_width_ = precision_map_[max_prec_];
     whole_width_ = dec_width_ + int_width_ + 1;
-    if (whole_width_ >= 64) {
-        Array<double> result(batch_size_);
-        for (auto &item: result) {
-            item = Double::LongBitsToDouble(input_bit_stream_->ReadLong(64));
-        }
-        return result;
-    }
     column_count_ = whole_width_ / 8;
     if (whole_width_ % 8 != 0) {
         column_count_++;
     }
-    cols_ = Array<Array<uint8_t>>(column_count_);
-    for (auto &item: cols_) item = Array<uint8_t>(batch_size_);
+}
+
+void BuffDecompressor::decodeBody(double *output) {
+    if (whole_width_ >= 64) {
+        for (int i = 0; i < batch_size_; ++i) {
+            output[i] = decodeRawValue();
+        }
+        return;
+    }
     sparseDecode();
-    return mergeDoubles();
+    mergeDoubles(output);
 }
 
-SparseResult BuffDecompressor::deserialize() {
-    SparseResult result(batch_size_);
-    result.set_frequent_value(input_bit_stream_->ReadInt(8));
-    for (int i = 0; i < batch_size_ / 8; ++i) {
-        result.bitmap_[i] = input_bit_stream_->ReadInt(8);
+void BuffDecompressor::deserialize(uint8_t *col) {
+    auto frequent_value = (uint8_t) input_bit_stream_->ReadInt(8);
+    // Outlier positions are kept as a mask in the column itself until the
+    // outlier bytes, which follow the whole bitmap, are read
+    int j = 0;
+    int outliers_count = 0;
+    for (; j + 8 <= batch_size_; j += 8) {
+        uint32_t bitmap = input_bit_stream_->ReadInt(8);
+        outliers_count += __builtin_popcount(bitmap);
+        for (int k = 0; k < 8; ++k) col[j + k] = (bitmap >> (7 - k)) & 1;
     }
-    result.bitmap_[batch_size_ / 8] = input_bit_stream_->ReadInt(
-            batch_size_ % 8);
-    int count = 0;
-    for (const auto &b: result.bitmap_) {
-        for (int i = 0; i < 8; ++i) {
-            count += (b >> i) & 1;
-        }
+    if (j < batch_size_) {
+        int tail = batch_size_ % 8;
+        uint32_t bitmap = input_bit_stream_->ReadInt(tail);
+        outliers_count += __builtin_popcount(bitmap);
+        for (int k = 0; k < tail; ++k) col[j + k] = (bitmap >> (tail - 1 - k)) & 1;
     }
-    for (int i = 0; i < count; ++i) {
-        result.get_outliers()[i] = (uint8_t) input_bit_stream_->ReadInt(8);
+    if (outliers_count == 0) {
+        std::memset(col, frequent_value, batch_size_);
+        return;
+    }
+    for (j = 0; j < batch_size_; ++j) {
+        col[j] = col[j] ? (uint8_t) input_bit_stream_->ReadInt(8) : frequent_value;
     }
-
-    return result;
 }
 
 void BuffDecompressor::sparseDecode() {
+    int pack_width = BuffCompressor::getPackWidth(column_count_);
+    size_t total = static_cast<size_t>(batch_size_) * pack_width;
+    if (cols_.size() < total) cols_.resize(total);
+    if (packed_.size() < total) packed_.resize(total);
+    // Planes above the most significant column stay zero
+    std::memset(cols_.data() + static_cast<size_t>(column_count_) * batch_size_, 0,
+                static_cast<size_t>(pack_width - column_count_) * batch_size_);
+
     for (int i = 0; i < column_count_; ++i) {
-        if (input_bit_stream_->ReadBit() == 0) {
-            for (int j = 0; j < batch_size_; ++j) {
-                cols_[i][j] = input_bit_stream_->ReadInt(8);
-            }
-        } else {
-            SparseResult result = deserialize();
-            int index, offset, vec_count = 0;
-            for (int j = 0; j < batch_size_; ++j) {
-                index = j / 8;
-                offset = j % 8;
-                if ((result.bitmap_[index] & (1 << (7 - offset))) == 0) {
-                    cols_[i][j] = result.frequent_value_;
-                } else {
-                    cols_[i][j] = result.outliers_[vec_count++];
-                }
-            }
+        decodeColumn(cols_.data() + static_cast<size_t>(column_count_ - 1 - i) * batch_size_);
+    }
+}
+
+void BuffDecompressor::decodeColumn(uint8_t *col) {
+    if (input_bit_stream_->ReadBit() == 0) {
+        for (int j = 0; j < batch_size_; ++j) {
+            col[j] = input_bit_stream_->ReadInt(8);
         }
+    } else {
+        deserialize(col);
     }
 }
 
-Array<double> BuffDecompressor::mergeDoubles() {
-    Array<double> dbs(batch_size_);
+double BuffDecompressor::decodeRawValue() {
+    return Double::LongBitsToDouble(input_bit_stream_->ReadLong(64));
+}
+
+void BuffDecompressor::mergeDoubles(double *output) {
+    int pack_width = BuffCompressor::getPackWidth(column_count_);
+    Prefilter::ByteUnshuffle(cols_.data(), packed_.data(), batch_size_, pack_width);
+
+    int remain = whole_width_ % 8;
+    double scale = 1.0 / static_cast<double>(1ULL << dec_width_);
+    double pow10 = kPowersOfTen[max_prec_];
     for (int i = 0; i < batch_size_; ++i) {
         uint64_t bit_pack = 0;
-        int remain = whole_width_ % 8;
-        if (remain == 0) {
-            for (int j = 0; j < column_count_; ++j) {
-                bit_pack = (bit_pack << 8) | (cols_[j][i] & last_mask_[7]);
-            }
-        } else {
-            for (int j = 0; j < column_count_ - 1; ++j) {
-                bit_pack = (bit_pack << 8) | (cols_[j][i] & last_mask_[7]);
-            }
-            bit_pack = (bit_pack << remain) | (cols_[column_count_ - 1][i] & last_mask_[remain - 1]);
+        std::memcpy(&bit_pack, packed_.data() + static_cast<size_t>(i) * pack_width, pack_width);
+        if (remain != 0) {
+            bit_pack = (bit_pack >> 8 << remain) | (bit_pack & last_mask_[remain - 1]);
         }
 
         int64_t offset = (int_width_ != 0) ? (bit_pack << 65 - whole_width_ >> 64 - int_width_) : 0;
         int64_t integer = lower_bound_ + offset;
-        uint64_t decimal = bit_pack << (64 - dec_width_) >> (64 - dec_width_);
-        uint64_t modified_decimal = decimal << (dec_width_ - getWidthNeeded(decimal));
-        int64_t exp = integer != 0 ? (getWidthNeeded(std::abs(integer)) + 1022) : 1023 - (dec_width_ - getWidthNeeded(decimal) + 1);
-        int64_t exp_value = exp - 1023;
-        int tmp = 53 - dec_width_ - getWidthNeeded(std::abs(integer));
-
-        long implicit_mantissa = (std::abs(integer) << tmp + dec_width_)
-                | (exp_value < 0 ? (tmp >= 0 ? (modified_decimal << tmp) : (modified_decimal >> std::abs(tmp)))
-                : tmp >= 0
-                ? (decimal << (tmp))
-                : (decimal >> std::abs(tmp)));
-
-        uint64_t mantissa = implicit_mantissa & 0x000FFFFFFFFFFFFFL;
-        long sign = bit_pack >> (whole_width_ - 1);
-        long bits = (sign << 63) | (exp << 52) | mantissa;
-        double db = Double::LongBitsToDouble(bits);
-
-        double round_num = 0.5;
-        for (int j = 0; j < max_prec_; j++) {
-          round_num /= 10;
-        }
-        db += round_num;
-        std::ostringstream convert_stream;
-        convert_stream << std::fixed << std::setprecision(max_prec_) << db;
-        db = std::stod(convert_stream.str());
+        uint64_t decimal = dec_width_ != 0 ? bit_pack << (64 - dec_width_) >> (64 - dec_width_) : 0;
+        uint64_t sign = bit_pack >> (whole_width_ - 1);
 
-        if (db == 0 && sign == 1) db = -db;
-        dbs[i] = db;
+        // The decimal part is truncated to dec_width_ bits, which is always
+        // finer than half a unit of the max_prec_-th digit, so rounding to the
+        // nearest decimal restores the original value.
+        double magnitude = static_cast<double>(std::abs(integer)) + static_cast<double>(decimal) * scale;
+        double db = std::round(magnitude * pow10) / pow10;
+        output[i] = sign ? -db : db;
     }
-    return dbs;
 }
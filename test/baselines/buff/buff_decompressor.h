@@ -12,12 +12,48 @@
 
 class BuffDecompressor {
 public:
-    explicit BuffDecompressor(Array<uint8_t> bs);
+    explicit BuffDecompressor(const Array<uint8_t> &bs);
     static int getWidthNeeded(uint64_t number);
     Array<double> decompress();
-    SparseResult deserialize();
+    // Writes batch_size() values into output and returns their count
+    int decompress(double *output);
+    void readHeader();
+    void decodeBody(double *output);
+    void deserialize(uint8_t *col);
+    // Reads the next byte column of the stream, most significant first
+    void decodeColumn(uint8_t *col);
+    // Reads the next value of a block stored with whole_width() >= 64
+    double decodeRawValue();
     void sparseDecode();
-    Array<double> mergeDoubles();
+    void mergeDoubles(double *output);
+
+    int batch_size() const {
+        return batch_size_;
+    }
+
+    int column_count() const {
+        return column_count_;
+    }
+
+    long lower_bound() const {
+        return lower_bound_;
+    }
+
+    int max_prec() const {
+        return max_prec_;
+    }
+
+    int dec_width() const {
+        return dec_width_;
+    }
+
+    int int_width() const {
+        return int_width_;
+    }
+
+    int whole_width() const {
+        return whole_width_;
+    }
 
 private:
     static constexpr int precision_map_[] = {0, 5, 8, 11, 15, 18, 21, 25, 28, 31, 35, 38, 50, 52, 52, 52, 64, 64, 64,
@@ -32,7 +68,9 @@ private:
     int dec_width_;
     int int_width_;
     int whole_width_;
-    Array<Array<uint8_t>> cols_;
+    // Byte columns back to back, the most significant column last
+    std::vector<uint8_t> cols_;
+    std::vector<uint8_t> packed_;
 };
 
 
@@ -0,0 +1,307 @@
+#include "buff_query.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr double kPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+                                   1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Narrows the [lo, hi] key interval test by one byte column. A row stays
+// undecided while its key prefix equals the prefix of one of the bounds.
+// Returns whether any row is still undecided.
+bool filterColumn(const uint8_t *col, const uint8_t *neg, uint8_t dec_mask, uint8_t lo_pos, uint8_t lo_neg,
+                  uint8_t hi_pos, uint8_t hi_neg, uint8_t *alive, uint8_t *lo_eq, uint8_t *hi_eq, int n) {
+    int i = 0;
+    bool undecided = false;
+#if defined(__SSE2__)
+    const __m128i v_dec_mask = _mm_set1_epi8(static_cast<char>(dec_mask));
+    const __m128i v_lo_pos = _mm_set1_epi8(static_cast<char>(lo_pos));
+    const __m128i v_lo_neg = _mm_set1_epi8(static_cast<char>(lo_neg));
+    const __m128i v_hi_pos = _mm_set1_epi8(static_cast<char>(hi_pos));
+    const __m128i v_hi_neg = _mm_set1_epi8(static_cast<char>(hi_neg));
+    __m128i v_undecided = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i v_neg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(neg + i));
+        __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(col + i)),
+                                  _mm_and_si128(v_neg, v_dec_mask));
+        __m128i lo = _mm_or_si128(_mm_and_si128(v_neg, v_lo_neg), _mm_andnot_si128(v_neg, v_lo_pos));
+        __m128i hi = _mm_or_si128(_mm_and_si128(v_neg, v_hi_neg), _mm_andnot_si128(v_neg, v_hi_pos));
+        __m128i v_alive = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alive + i));
+        __m128i v_lo_eq = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lo_eq + i));
+        __m128i v_hi_eq = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hi_eq + i));
+        // Unsigned x >= lo and x <= hi
+        __m128i ge_lo = _mm_cmpeq_epi8(_mm_max_epu8(x, lo), x);
+        __m128i le_hi = _mm_cmpeq_epi8(_mm_min_epu8(x, hi), x);
+        v_alive = _mm_andnot_si128(_mm_andnot_si128(ge_lo, v_lo_eq), v_alive);
+        v_alive = _mm_andnot_si128(_mm_andnot_si128(le_hi, v_hi_eq), v_alive);
+        v_lo_eq = _mm_and_si128(v_lo_eq, _mm_cmpeq_epi8(x, lo));
+        v_hi_eq = _mm_and_si128(v_hi_eq, _mm_cmpeq_epi8(x, hi));
+        v_undecided = _mm_or_si128(v_undecided, _mm_and_si128(v_alive, _mm_or_si128(v_lo_eq, v_hi_eq)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(alive + i), v_alive);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lo_eq + i), v_lo_eq);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(hi_eq + i), v_hi_eq);
+    }
+    undecided = _mm_movemask_epi8(v_undecided) != 0;
+#endif
+    for (; i < n; ++i) {
+        uint8_t x = col[i] ^ (neg[i] & dec_mask);
+        uint8_t lo = neg[i] ? lo_neg : lo_pos;
+        uint8_t hi = neg[i] ? hi_neg : hi_pos;
+        if (lo_eq[i] && x < lo) alive[i] = 0;
+        if (hi_eq[i] && x > hi) alive[i] = 0;
+        lo_eq[i] &= (x == lo) ? 0xFF : 0;
+        hi_eq[i] &= (x == hi) ? 0xFF : 0;
+        undecided |= alive[i] && (lo_eq[i] || hi_eq[i]);
+    }
+    return undecided;
+}
+
+int countSet(const uint8_t *flags, int n) {
+    int i = 0;
+    int count = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(flags + i))));
+    }
+#endif
+    for (; i < n; ++i) count += flags[i] != 0;
+    return count;
+}
+
+// Reduces one column over the candidate rows to its max (or min) byte and
+// drops the candidates that do not hold it.
+uint8_t narrowColumn(const uint8_t *col, const uint8_t *neg, uint8_t dec_mask, uint8_t *cand, int n, bool take_max) {
+    uint8_t best = take_max ? 0 : 0xFF;
+    for (int i = 0; i < n; ++i) {
+        if (!cand[i]) continue;
+        uint8_t x = col[i] ^ (neg[i] & dec_mask);
+        best = take_max ? std::max(best, x) : std::min(best, x);
+    }
+    for (int i = 0; i < n; ++i) {
+        uint8_t x = col[i] ^ (neg[i] & dec_mask);
+        cand[i] &= (x == best) ? 0xFF : 0;
+    }
+    return best;
+}
+
+}  // namespace
+
+BuffQuery::BuffQuery(const Array<uint8_t> &bs) : decompressor_(bs) {
+    decompressor_.readHeader();
+    batch_size_ = decompressor_.batch_size();
+    column_count_ = decompressor_.column_count();
+    whole_width_ = decompressor_.whole_width();
+    dec_width_ = decompressor_.dec_width();
+    lower_bound_ = decompressor_.lower_bound();
+    pow10_ = kPowersOfTen[decompressor_.max_prec()];
+    scale_ = 1.0 / static_cast<double>(1ULL << std::min(dec_width_, 63));
+    if (whole_width_ >= 64) {
+        raw_ = true;
+        raw_values_.resize(batch_size_);
+        for (auto &value: raw_values_) value = decompressor_.decodeRawValue();
+        return;
+    }
+    cols_.resize(static_cast<size_t>(column_count_) * batch_size_);
+    negative_.resize(batch_size_);
+    alive_.resize(batch_size_);
+    lo_eq_.resize(batch_size_);
+    hi_eq_.resize(batch_size_);
+}
+
+const uint8_t *BuffQuery::column(int k) {
+    while (decoded_columns_ <= k) {
+        uint8_t *col = cols_.data() + static_cast<size_t>(decoded_columns_) * batch_size_;
+        decompressor_.decodeColumn(col);
+        if (decoded_columns_ == 0) {
+            int sign_shift = (column_count_ == 1) ? whole_width_ - 1 : 7;
+            for (int i = 0; i < batch_size_; ++i) negative_[i] = ((col[i] >> sign_shift) & 1) ? 0xFF : 0;
+        }
+        decoded_columns_++;
+    }
+    return cols_.data() + static_cast<size_t>(k) * batch_size_;
+}
+
+uint64_t BuffQuery::columnByte(uint64_t code, int k) const {
+    int last = column_count_ - 1;
+    int remain = whole_width_ % 8;
+    int width = (k == last && remain != 0) ? remain : 8;
+    int shift = (k == last) ? 0 : whole_width_ - 8 * (k + 1);
+    return (code >> shift) & ((1ULL << width) - 1);
+}
+
+double BuffQuery::keyValue(uint64_t key, bool negative) const {
+    uint64_t dec_mask = (1ULL << dec_width_) - 1;
+    int64_t integer = lower_bound_ + static_cast<int64_t>(key >> dec_width_);
+    uint64_t decimal = negative ? (~key & dec_mask) : (key & dec_mask);
+    double fraction = static_cast<double>(decimal) * scale_;
+    double value = negative ? static_cast<double>(integer) - fraction : static_cast<double>(integer) + fraction;
+    return std::round(value * pow10_) / pow10_;
+}
+
+uint64_t BuffQuery::firstKeyAbove(double c, bool negative, bool inclusive) const {
+    // keyValue is monotone in the key, so the boundary is found by bisection
+    uint64_t lo = 0;
+    uint64_t hi = 1ULL << (whole_width_ - 1);
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        double value = keyValue(mid, negative);
+        if (inclusive ? value >= c : value > c) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+uint64_t BuffQuery::rowCode(int row) {
+    uint64_t code = 0;
+    for (int k = 0; k < column_count_; ++k) {
+        int last = column_count_ - 1;
+        int remain = whole_width_ % 8;
+        int width = (k == last && remain != 0) ? remain : 8;
+        code = (code << width) | column(k)[row];
+    }
+    return code;
+}
+
+void BuffQuery::filter(double lo, bool lo_inclusive, double hi) {
+    const uint64_t sign_bit = 1ULL << (whole_width_ - 1);
+    const uint64_t key_max = sign_bit - 1;
+    const uint64_t dec_mask = (1ULL << dec_width_) - 1;
+
+    // Key bounds per sign, as full codes so that their bytes line up with the
+    // columns
+    uint64_t lo_code[2], hi_code[2];
+    bool empty[2], lo_open[2], hi_open[2];
+    for (int negative = 0; negative < 2; ++negative) {
+        uint64_t lo_key = firstKeyAbove(lo, negative, lo_inclusive);
+        uint64_t hi_end = std::isinf(hi) && hi > 0 ? sign_bit : firstKeyAbove(hi, negative, false);
+        empty[negative] = lo_key >= hi_end;
+        uint64_t hi_key = empty[negative] ? 0 : hi_end - 1;
+        lo_open[negative] = lo_key == 0;
+        hi_open[negative] = hi_key == key_max;
+        uint64_t sign = negative ? sign_bit : 0;
+        lo_code[negative] = sign | lo_key;
+        hi_code[negative] = sign | hi_key;
+    }
+
+    column(0);
+    const uint8_t *neg = negative_.data();
+    for (int i = 0; i < batch_size_; ++i) {
+        int negative = neg[i] ? 1 : 0;
+        alive_[i] = empty[negative] ? 0 : 0xFF;
+        lo_eq_[i] = lo_open[negative] ? 0 : 0xFF;
+        hi_eq_[i] = hi_open[negative] ? 0 : 0xFF;
+    }
+
+    for (int k = 0; k < column_count_; ++k) {
+        bool undecided = filterColumn(column(k), neg, static_cast<uint8_t>(columnByte(dec_mask, k)),
+                                      static_cast<uint8_t>(columnByte(lo_code[0], k)),
+                                      static_cast<uint8_t>(columnByte(lo_code[1], k)),
+                                      static_cast<uint8_t>(columnByte(hi_code[0], k)),
+                                      static_cast<uint8_t>(columnByte(hi_code[1], k)),
+                                      alive_.data(), lo_eq_.data(), hi_eq_.data(), batch_size_);
+        if (!undecided) break;
+    }
+}
+
+int BuffQuery::countGreater(double c) {
+    if (raw_) {
+        int count = 0;
+        for (const auto &value: raw_values_) count += value > c;
+        return count;
+    }
+    filter(c, false, std::numeric_limits<double>::infinity());
+    return countSet(alive_.data(), batch_size_);
+}
+
+void BuffQuery::selectGreater(double c, std::vector<int> &rows) {
+    rows.clear();
+    if (raw_) {
+        for (int i = 0; i < batch_size_; ++i) if (raw_values_[i] > c) rows.push_back(i);
+        return;
+    }
+    filter(c, false, std::numeric_limits<double>::infinity());
+    for (int i = 0; i < batch_size_; ++i) if (alive_[i]) rows.push_back(i);
+}
+
+int BuffQuery::countBetween(double a, double b) {
+    if (raw_) {
+        int count = 0;
+        for (const auto &value: raw_values_) count += (value >= a && value <= b);
+        return count;
+    }
+    filter(a, true, b);
+    return countSet(alive_.data(), batch_size_);
+}
+
+void BuffQuery::selectBetween(double a, double b, std::vector<int> &rows) {
+    rows.clear();
+    if (raw_) {
+        for (int i = 0; i < batch_size_; ++i) if (raw_values_[i] >= a && raw_values_[i] <= b) rows.push_back(i);
+        return;
+    }
+    filter(a, true, b);
+    for (int i = 0; i < batch_size_; ++i) if (alive_[i]) rows.push_back(i);
+}
+
+double BuffQuery::max() {
+    if (raw_) return *std::max_element(raw_values_.begin(), raw_values_.end());
+    column(0);
+    // The largest value is positive if any positive row exists
+    bool negative = countSet(negative_.data(), batch_size_) == batch_size_;
+    const uint64_t dec_mask = (1ULL << dec_width_) - 1;
+    std::vector<uint8_t> &cand = alive_;
+    for (int i = 0; i < batch_size_; ++i) cand[i] = (negative_[i] != 0) == negative ? 0xFF : 0;
+    uint64_t code = 0;
+    for (int k = 0; k < column_count_; ++k) {
+        int width = (k == column_count_ - 1 && whole_width_ % 8 != 0) ? whole_width_ % 8 : 8;
+        uint8_t best = narrowColumn(column(k), negative_.data(), static_cast<uint8_t>(columnByte(dec_mask, k)),
+                                    cand.data(), batch_size_, true);
+        code = (code << width) | best;
+    }
+    return keyValue(code & ((1ULL << (whole_width_ - 1)) - 1), negative);
+}
+
+double BuffQuery::min() {
+    if (raw_) return *std::min_element(raw_values_.begin(), raw_values_.end());
+    column(0);
+    // The smallest value is negative if any negative row exists
+    bool negative = countSet(negative_.data(), batch_size_) != 0;
+    const uint64_t dec_mask = (1ULL << dec_width_) - 1;
+    std::vector<uint8_t> &cand = alive_;
+    for (int i = 0; i < batch_size_; ++i) cand[i] = (negative_[i] != 0) == negative ? 0xFF : 0;
+    uint64_t code = 0;
+    for (int k = 0; k < column_count_; ++k) {
+        int width = (k == column_count_ - 1 && whole_width_ % 8 != 0) ? whole_width_ % 8 : 8;
+        uint8_t best = narrowColumn(column(k), negative_.data(), static_cast<uint8_t>(columnByte(dec_mask, k)),
+                                    cand.data(), batch_size_, false);
+        code = (code << width) | best;
+    }
+    return keyValue(code & ((1ULL << (whole_width_ - 1)) - 1), negative);
+}
+
+double BuffQuery::sum() {
+    double total = 0;
+    if (raw_) {
+        for (const auto &value: raw_values_) total += value;
+        return total;
+    }
+    column(column_count_ - 1);
+    const uint64_t key_mask = (1ULL << (whole_width_ - 1)) - 1;
+    const uint64_t dec_mask = (1ULL << dec_width_) - 1;
+    for (int i = 0; i < batch_size_; ++i) {
+        bool negative = negative_[i] != 0;
+        uint64_t key = (rowCode(i) & key_mask) ^ (negative ? dec_mask : 0);
+        total += keyValue(key, negative);
+    }
+    return total;
+}
@@ -0,0 +1,71 @@
+#ifndef BUFF_QUERY_H
+#define BUFF_QUERY_H
+
+
+#include <cstdint>
+#include <vector>
+
+#include "array.h"
+#include "buff_decompressor.h"
+
+// Predicates and aggregates evaluated on one BUFF block without rebuilding the
+// doubles. Byte columns are read most significant first and a column is only
+// decoded while some row is still undecided, so selective filters stop after
+// one or two columns.
+//
+// Rows are compared through an order preserving key: the fixed-point code
+// itself for positive values, and the code with its decimal bits inverted for
+// negative ones (their integer part is stored signed, the decimal part as
+// magnitude). Each sign has its own key bounds, derived from the query
+// constants with the same rounding as BuffDecompressor, so the results match
+// decompress-then-filter exactly.
+class BuffQuery {
+public:
+    explicit BuffQuery(const Array<uint8_t> &bs);
+
+    // v > c
+    int countGreater(double c);
+    void selectGreater(double c, std::vector<int> &rows);
+    // a <= v <= b
+    int countBetween(double a, double b);
+    void selectBetween(double a, double b, std::vector<int> &rows);
+    double max();
+    double min();
+    double sum();
+
+    int batch_size() const {
+        return batch_size_;
+    }
+
+private:
+    BuffDecompressor decompressor_;
+    int batch_size_;
+    int column_count_;
+    int whole_width_;
+    int dec_width_;
+    long lower_bound_;
+    double pow10_;
+    double scale_;
+    // Blocks wider than 64 bits are stored as raw doubles
+    bool raw_ = false;
+    std::vector<double> raw_values_;
+    // Byte columns, most significant first, decoded on demand
+    std::vector<uint8_t> cols_;
+    int decoded_columns_ = 0;
+    // Per row flags: 0xFF for negative rows, and the filter state
+    std::vector<uint8_t> negative_;
+    std::vector<uint8_t> alive_;
+    std::vector<uint8_t> lo_eq_;
+    std::vector<uint8_t> hi_eq_;
+
+    const uint8_t *column(int k);
+    uint64_t columnByte(uint64_t code, int k) const;
+    double keyValue(uint64_t key, bool negative) const;
+    uint64_t firstKeyAbove(double c, bool negative, bool inclusive) const;
+    uint64_t rowCode(int row);
+    // Leaves alive_ set for the rows whose value lies in [lo, hi]
+    void filter(double lo, bool lo_inclusive, double hi);
+};
+
+
+#endif // BUFF_QUERY_H
@@ -2,25 +2,20 @@
 #define SPARSE_RESULT_H
 
 
-#include <vector>
 #include <cstdint>
 
-#include "array.h"
-
+// Outcome of the majority vote over one byte column. The bitmap and the
+// outliers are not materialized; the sparse encoder reads them straight from
+// the column.
 class SparseResult {
 public:
-    bool flag_;
+    bool flag_ = false;
     uint8_t frequent_value_ = 0;
-    Array<uint8_t> bitmap_;
-    Array<bool> is_frequent_value_;
-    Array<uint8_t> outliers_;
     int outliers_count_ = 0;
 
-    explicit SparseResult(int batch_size);
+    SparseResult() = default;
 
     void set_frequent_value(int frequent_value);
-
-    Array<uint8_t> &get_outliers();
 };
 
 
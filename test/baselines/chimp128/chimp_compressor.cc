@@ -1,69 +1,84 @@
 #include "chimp_compressor.h"
 
-ChimpCompressor::ChimpCompressor(int previousValues) {
-    output_bit_stream_ = std::make_unique<OutputBitStream>(1000 * 8);
-    size_ = 0;
-    previousValues_ = previousValues;
-    previousValuesLog2_ = (int) (std::log(previousValues_) / std::log(2));
-    threshold_ = 6 + previousValuesLog2_;
-    setLsb_ = (int) std::pow(2, threshold_ + 1) - 1;
-    indices_ = std::make_unique<int []>((int) std::pow(2, threshold_ + 1));
-    storedValues_ = std::make_unique<uint64_t []>(previousValues_);
-    flagZeroSize_ = previousValuesLog2_ + 2;
-    flagOneSize_ = previousValuesLog2_ + 11;
+#include <algorithm>
+#include <cstring>
+
+template<int kPreviousValues, typename T>
+ChimpNCompressor<kPreviousValues, T>::ChimpNCompressor(bool with_stats) : header_(with_stats) {
+    output_bit_stream_ = std::make_unique<OutputBitStream>(1000 * sizeof(T));
+    indices_ = std::make_unique<uint32_t []>(kSetLsb + 1);
+    storedValues_ = std::make_unique<Bits []>(kPreviousValues);
+    startBlock();
+}
+
+template<int kPreviousValues, typename T>
+void ChimpNCompressor<kPreviousValues, T>::startBlock() {
+    output_bit_stream_->Refresh();
+    header_.Clear();
+    // Room for the header, stored by get_compress_pack()
+    for (size_t i = 0; i < header_.size(); ++i) {
+        output_bit_stream_->WriteInt(0, 8);
+    }
+    size_ = header_.size() * 8;
+    storedLeadingZeros_ = std::numeric_limits<int>::max();
+    first_ = true;
 }
 
-void ChimpCompressor::addValue(double v) {
-    uint64_t value = Double::DoubleToLongBits(v);
+template<int kPreviousValues, typename T>
+void ChimpNCompressor<kPreviousValues, T>::addValue(T v) {
+    header_.Add(v);
+    Bits value = Traits::ToBits(v);
     if (first_) {
         first_ = false;
-        storedValues_[current_] = value;
-        size_ += output_bit_stream_->WriteLong(storedValues_[current_], 64);
-        indices_[((int) value) & setLsb_] = index_;
+        storedValues_[index_ & kRingMask] = value;
+        size_ += output_bit_stream_->WriteLong(value, Traits::kBits);
+        indices_[((int) value) & kSetLsb] = index_;
     } else {
-        int key = (int) value & setLsb_;
-        uint64_t xored_value;
+        int key = (int) value & kSetLsb;
+        Bits xored_value;
         int previousIndex;
         int trailingZeros = 0;
-        int curIndex = indices_[key];
-        if ((index_ - curIndex) < previousValues_) {
-            uint64_t tempXor = value ^ storedValues_[curIndex % previousValues_];
-            trailingZeros = __builtin_ctzll(tempXor);
-            if (trailingZeros > threshold_) {
-                previousIndex = curIndex % previousValues_;
+        uint32_t curIndex = std::max(indices_[key], blockStart_);
+        if (index_ - curIndex < static_cast<uint32_t>(kPreviousValues)) {
+            Bits tempXor = value ^ storedValues_[curIndex & kRingMask];
+            trailingZeros = Traits::Ctz(tempXor);
+            if (trailingZeros > kThreshold) {
+                previousIndex = curIndex & kRingMask;
                 xored_value = tempXor;
             } else {
-                previousIndex = index_ % previousValues_;
+                previousIndex = index_ & kRingMask;
                 xored_value = storedValues_[previousIndex] ^ value;
+                if (kPreviousTrailingZeros && xored_value != 0) trailingZeros = Traits::Ctz(xored_value);
             }
         } else {
-            previousIndex = index_ % previousValues_;
+            previousIndex = index_ & kRingMask;
             xored_value = storedValues_[previousIndex] ^ value;
+            if (kPreviousTrailingZeros && xored_value != 0) trailingZeros = Traits::Ctz(xored_value);
         }
 
         if (xored_value == 0) {
-            size_ += output_bit_stream_->WriteInt(previousIndex, flagZeroSize_);
-            storedLeadingZeros_ = 65;
+            size_ += output_bit_stream_->WriteInt(previousIndex, kFlagZeroSize);
+            storedLeadingZeros_ = Traits::kBits + 1;
         } else {
-            int leadingZeros = leadingRnd_[__builtin_clzll(xored_value)];
+            int leadingZeros = leadingRnd_[Traits::Clz(xored_value)];
 
-            if (trailingZeros > threshold_) {
-                int significantBits = 64 - leadingZeros - trailingZeros;
+            if (trailingZeros > kThreshold) {
+                int significantBits = Traits::kBits - leadingZeros - trailingZeros;
                 size_ += output_bit_stream_->WriteInt(
-                        512 * (previousValues_ + previousIndex) +
-                        64 * leadingRep_[leadingZeros] + significantBits,
-                        flagOneSize_);
+                        ((kPreviousValues + previousIndex) << (3 + Traits::kBitsLog2)) +
+                        (leadingRep_[leadingZeros] << Traits::kBitsLog2) + significantBits,
+                        kFlagOneSize);
                 size_ += output_bit_stream_->WriteLong(
                         xored_value >> trailingZeros, significantBits);
-                storedLeadingZeros_ = 65;
+                storedLeadingZeros_ = Traits::kBits + 1;
             } else if (leadingZeros == storedLeadingZeros_) {
                 size_ += output_bit_stream_->WriteInt(2, 2);
-                int significantBits = 64 - leadingZeros;
+                int significantBits = Traits::kBits - leadingZeros;
                 size_ += output_bit_stream_->WriteLong(xored_value,
                                                        significantBits);
             } else {
                 storedLeadingZeros_ = leadingZeros;
-                int significantBits = 64 - leadingZeros;
+                int significantBits = Traits::kBits - leadingZeros;
                 size_ += output_bit_stream_->WriteInt(
                         24 + leadingRep_[leadingZeros], 5);
                 size_ += output_bit_stream_->WriteLong(xored_value,
@@ -71,23 +86,46 @@ void ChimpCompressor::addValue(double v) {
             }
         }
 
-        current_ = (current_ + 1) % previousValues_;
-        storedValues_[current_] = value;
         index_++;
+        storedValues_[index_ & kRingMask] = value;
         indices_[key] = index_;
     }
 }
 
-void ChimpCompressor::close() {
-    addValue(std::numeric_limits<double>::quiet_NaN());
+template<int kPreviousValues, typename T>
+void ChimpNCompressor<kPreviousValues, T>::close() {
     output_bit_stream_->Flush();
 }
 
-long ChimpCompressor::get_size() {
+template<int kPreviousValues, typename T>
+void ChimpNCompressor<kPreviousValues, T>::reset() {
+    // The next multiple of the window above every index in the table
+    blockStart_ = (index_ + kPreviousValues) & ~static_cast<uint32_t>(kRingMask);
+    if (blockStart_ > kMaxIndex) {
+        std::memset(indices_.get(), 0, (kSetLsb + 1) * sizeof(uint32_t));
+        blockStart_ = 0;
+    }
+    index_ = blockStart_;
+    startBlock();
+}
+
+template<int kPreviousValues, typename T>
+long ChimpNCompressor<kPreviousValues, T>::get_size() {
     return size_;
 }
 
-Array<uint8_t> ChimpCompressor::get_compress_pack() {
+template<int kPreviousValues, typename T>
+Array<uint8_t> ChimpNCompressor<kPreviousValues, T>::get_compress_pack() {
     compress_pack_ = output_bit_stream_->GetBuffer(std::ceil(size_ / 8.0));
+    header_.Store(compress_pack_.begin());
     return compress_pack_;
 }
+
+template class ChimpNCompressor<32>;
+template class ChimpNCompressor<64>;
+template class ChimpNCompressor<128>;
+template class ChimpNCompressor<256>;
+template class ChimpNCompressor<32, float>;
+template class ChimpNCompressor<64, float>;
+template class ChimpNCompressor<128, float>;
+template class ChimpNCompressor<256, float>;
@@ -5,24 +5,63 @@
 #include <memory>
 #include <limits>
 #include <cmath>
+#include <type_traits>
 
 #include "output_bit_stream.h"
-#include "double.h"
+#include "stream_header.h"
+#include "float_traits.h"
 #include "array.h"
 
-class ChimpCompressor {
+// ChimpN over the bits of a T, with a compile-time window of kPreviousValues
+// values. The window is a power of two, so ring positions are masks.
+// Instantiated for N = 32, 64, 128 and 256 and for double and float in
+// chimp_compressor.cc. The stream starts with a bitstream::StreamHeader holding
+// the value count; with_stats also stores the first/last/min/max there.
+template<int kPreviousValues, typename T = double>
+class ChimpNCompressor {
 public:
-    explicit ChimpCompressor(int previousValues);
+    static_assert(kPreviousValues > 0 && (kPreviousValues & (kPreviousValues - 1)) == 0,
+                  "window size must be a power of two");
 
-    void addValue(double v);
+    explicit ChimpNCompressor(bool with_stats = false);
+
+    void addValue(T v);
 
     void close();
 
+    // Starts a new block without clearing the index table
+    void reset();
+
     Array<uint8_t> get_compress_pack();
 
     long get_size();
 
 private:
+    using Traits = bitstream::FloatTraits<T>;
+
+    using Bits = typename Traits::Bits;
+
+    static constexpr int kPreviousValuesLog2 = __builtin_ctz(kPreviousValues);
+
+    static constexpr int kRingMask = kPreviousValues - 1;
+
+    static constexpr int kThreshold = Traits::kBitsLog2 + kPreviousValuesLog2;
+
+    static constexpr int kSetLsb = (1 << (kThreshold + 1)) - 1;
+
+    static constexpr int kFlagZeroSize = kPreviousValuesLog2 + 2;
+
+    // flag:2, index, lead:3, significant bits
+    static constexpr int kFlagOneSize = kPreviousValuesLog2 + 5 + Traits::kBitsLog2;
+
+    // The float stream also takes the '01' case against the previous value
+    // when that xor has enough trailing zeros; the double stream only takes it
+    // for a match in the window. Both streams keep their original bytes.
+    static constexpr bool kPreviousTrailingZeros = std::is_same_v<T, float>;
+
+    // Once index_ passes this, reset() clears the index table and starts over
+    static constexpr uint32_t kMaxIndex = std::numeric_limits<uint32_t>::max() / 2;
+
     const uint16_t leadingRep_[64] = {
             0, 0, 0, 0, 0, 0, 0, 0,
             1, 1, 1, 1, 2, 2, 2, 2,
@@ -47,33 +86,42 @@ private:
 
     std::unique_ptr<OutputBitStream> output_bit_stream_;
 
+    bitstream::StreamHeader header_;
+
     int storedLeadingZeros_ = std::numeric_limits<int>::max();
 
-    int index_ = 0;
+    // Indices keep counting across blocks; blockStart_ is the index of the
+    // first value of the current block, a multiple of kPreviousValues so that
+    // index & kRingMask is also the position within the block's ring. Table
+    // entries below blockStart_ belong to earlier blocks and read as the block
+    // start, which is what a freshly zeroed table gives.
+    uint32_t index_ = 0;
 
-    int current_ = 0;
+    uint32_t blockStart_ = 0;
 
     long size_ = 0;
 
-    int previousValues_;
-
-    int previousValuesLog2_;
-
-    int threshold_;
-
-    int setLsb_;
-
-    std::unique_ptr<int []> indices_;
+    std::unique_ptr<uint32_t []> indices_;
 
-    std::unique_ptr<uint64_t []> storedValues_;
-
-    int flagZeroSize_;
-
-    int flagOneSize_;
+    std::unique_ptr<Bits []> storedValues_;
 
     bool first_ = true;
 
     Array<uint8_t> compress_pack_ = Array<uint8_t>(0);
+
+    void startBlock();
 };
 
-#endif // CHIMP_COMPRESSOR_H
\ No newline at end of file
+extern template class ChimpNCompressor<32>;
+extern template class ChimpNCompressor<64>;
+extern template class ChimpNCompressor<128>;
+extern template class ChimpNCompressor<256>;
+extern template class ChimpNCompressor<32, float>;
+extern template class ChimpNCompressor<64, float>;
+extern template class ChimpNCompressor<128, float>;
+extern template class ChimpNCompressor<256, float>;
+
+using ChimpCompressor = ChimpNCompressor<128>;
+using ChimpCompressor32 = ChimpNCompressor<128, float>;
+
+#endif // CHIMP_COMPRESSOR_H
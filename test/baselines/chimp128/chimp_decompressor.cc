@@ -1,68 +1,87 @@
 #include "chimp_decompressor.h"
 
-ChimpDecompressor::ChimpDecompressor(const Array<uint8_t> &bs, int previousValues) {
-    input_bit_stream_ = std::make_unique<InputBitStream>();
-    input_bit_stream_->SetBuffer(bs);
-    previousValues_ = previousValues;
-    previousValuesLog2_ = (int) (std::log(previousValues_) / std::log(2));
-    initialFill_ = previousValuesLog2_ + 9;
-    storedValues_ = Array<uint64_t>(previousValues);
+template<int kPreviousValues, typename T>
+ChimpNDecompressor<kPreviousValues, T>::ChimpNDecompressor(const Array<uint8_t> &bs) {
+    reset(bs);
 }
 
-std::vector<double> ChimpDecompressor::decompress() {
-    std::vector<double> values;
-    double cur_value;
-    while (!std::isnan(cur_value = nextValue())) {
-        values.emplace_back(cur_value);
+template<int kPreviousValues, typename T>
+void ChimpNDecompressor<kPreviousValues, T>::reset(const Array<uint8_t> &bs) {
+    header_ = bitstream::StreamHeader::Load(bs.begin(), bs.length());
+    input_bit_stream_->SetBuffer(bs.begin() + header_.size(), bs.length() - header_.size());
+    storedLeadingZeros_ = std::numeric_limits<int>::max();
+    storedTrailingZeros_ = 0;
+    stored_val_ = 0;
+    current_ = 0;
+}
+
+template<int kPreviousValues, typename T>
+const bitstream::StreamHeader &ChimpNDecompressor<kPreviousValues, T>::header() const {
+    return header_;
+}
+
+template<int kPreviousValues, typename T>
+int ChimpNDecompressor<kPreviousValues, T>::decompress(T *output) {
+    int count = static_cast<int>(header_.count);
+    if (count == 0) return 0;
+    stored_val_ = input_bit_stream_->ReadLong(Traits::kBits);
+    storedValues_[current_] = stored_val_;
+    output[0] = Traits::FromBits(stored_val_);
+    for (int i = 1; i < count; ++i) {
+        output[i] = nextValue();
     }
+    return count;
+}
+
+template<int kPreviousValues, typename T>
+std::vector<T> ChimpNDecompressor<kPreviousValues, T>::decompress() {
+    std::vector<T> values(header_.count);
+    decompress(values.data());
     return values;
 }
 
-double ChimpDecompressor::nextValue() {
-    if (first_) {
-        first_ = false;
-        stored_val_ = input_bit_stream_->ReadLong(64);
-        storedValues_[current_] = stored_val_;
-    } else {
-        int flag = input_bit_stream_->ReadInt(2);
-        uint64_t value;
-        if (flag == 3) {
-            storedLeadingZeros_ = leadingRep_[input_bit_stream_->ReadInt(3)];
-            value = input_bit_stream_->ReadLong(64 - storedLeadingZeros_);
-            value = stored_val_ ^ value;
-            stored_val_ = value;
-            current_ = (current_ + 1) % previousValues_;
-            storedValues_[current_] = stored_val_;
-        } else if (flag == 2) {
-            value = input_bit_stream_->ReadLong(64 - storedLeadingZeros_);
-            value = stored_val_ ^ value;
-            stored_val_ = value;
-            current_ = (current_ + 1) % previousValues_;
-            storedValues_[current_] = stored_val_;
-        } else if (flag == 1) {
-            int fill = initialFill_;
-            int temp = input_bit_stream_->ReadInt(fill);
-            int index = temp >> (fill -= previousValuesLog2_) & (1 << previousValuesLog2_) - 1;
-            storedLeadingZeros_ = leadingRep_[temp >> (fill -= 3) & (1 << 3) - 1];
-            int significant_bits = temp >> (fill -= 6) & (1 << 6) - 1;
-            stored_val_ = storedValues_[index];
-            if (significant_bits == 0) {
-                significant_bits = 64;
-            }
-            storedTrailingZeros_ = 64 - significant_bits - storedLeadingZeros_;
-            value = input_bit_stream_->ReadLong(
-                    64 - storedLeadingZeros_ - storedTrailingZeros_);
-            value <<= storedTrailingZeros_;
-            value = stored_val_ ^ value;
-            stored_val_ = value;
-            current_ = (current_ + 1) % previousValues_;
-            storedValues_[current_] = stored_val_;
-        } else {
-            stored_val_ = storedValues_[(int) input_bit_stream_->ReadLong(
-                    previousValuesLog2_)];
-            current_ = (current_ + 1) % previousValues_;
-            storedValues_[current_] = stored_val_;
+template<int kPreviousValues, typename T>
+T ChimpNDecompressor<kPreviousValues, T>::nextValue() {
+    int flag = input_bit_stream_->ReadInt(2);
+    Bits value;
+    if (flag == 3) {
+        storedLeadingZeros_ = leadingRep_[input_bit_stream_->ReadInt(3)];
+        value = input_bit_stream_->ReadLong(Traits::kBits - storedLeadingZeros_);
+        value = stored_val_ ^ value;
+        stored_val_ = value;
+    } else if (flag == 2) {
+        value = input_bit_stream_->ReadLong(Traits::kBits - storedLeadingZeros_);
+        value = stored_val_ ^ value;
+        stored_val_ = value;
+    } else if (flag == 1) {
+        int fill = kInitialFill;
+        int temp = input_bit_stream_->ReadInt(fill);
+        int index = temp >> (fill -= kPreviousValuesLog2) & kRingMask;
+        storedLeadingZeros_ = leadingRep_[temp >> (fill -= 3) & (1 << 3) - 1];
+        int significant_bits = temp >> (fill -= Traits::kBitsLog2) & (1 << Traits::kBitsLog2) - 1;
+        stored_val_ = storedValues_[index];
+        if (significant_bits == 0) {
+            significant_bits = Traits::kBits;
         }
+        storedTrailingZeros_ = Traits::kBits - significant_bits - storedLeadingZeros_;
+        value = input_bit_stream_->ReadLong(
+                Traits::kBits - storedLeadingZeros_ - storedTrailingZeros_);
+        value <<= storedTrailingZeros_;
+        value = stored_val_ ^ value;
+        stored_val_ = value;
+    } else {
+        stored_val_ = storedValues_[input_bit_stream_->ReadInt(kPreviousValuesLog2)];
     }
-    return Double::LongBitsToDouble(stored_val_);
+    current_ = (current_ + 1) & kRingMask;
+    storedValues_[current_] = stored_val_;
+    return Traits::FromBits(stored_val_);
 }
+
+template class ChimpNDecompressor<32>;
+template class ChimpNDecompressor<64>;
+template class ChimpNDecompressor<128>;
+template class ChimpNDecompressor<256>;
+template class ChimpNDecompressor<32, float>;
+template class ChimpNDecompressor<64, float>;
+template class ChimpNDecompressor<128, float>;
+template class ChimpNDecompressor<256, float>;
@@ -8,38 +8,73 @@
 
 #include "array.h"
 #include "input_bit_stream.h"
-#include "double.h"
+#include "stream_header.h"
+#include "float_traits.h"
 
-class ChimpDecompressor {
+// Decoder for ChimpNCompressor<kPreviousValues, T>; instantiated for the same
+// window sizes and types in chimp_decompressor.cc.
+template<int kPreviousValues, typename T = double>
+class ChimpNDecompressor {
 public:
-    explicit ChimpDecompressor(const Array<uint8_t> &bs, int previousValues);
+    static_assert(kPreviousValues > 0 && (kPreviousValues & (kPreviousValues - 1)) == 0,
+                  "window size must be a power of two");
 
-    std::vector<double> decompress();
+    ChimpNDecompressor() = default;
+
+    explicit ChimpNDecompressor(const Array<uint8_t> &bs);
+
+    // The header of the current stream, e.g. to size the output
+    const bitstream::StreamHeader &header() const;
+
+    // Writes header().count values to output, returns the count
+    int decompress(T *output);
+
+    std::vector<T> decompress();
+
+    // Starts over on a new block
+    void reset(const Array<uint8_t> &bs);
 
 private:
+    using Traits = bitstream::FloatTraits<T>;
+
+    using Bits = typename Traits::Bits;
+
+    static constexpr int kPreviousValuesLog2 = __builtin_ctz(kPreviousValues);
+
+    static constexpr int kRingMask = kPreviousValues - 1;
+
+    // index, lead:3, significant bits
+    static constexpr int kInitialFill = kPreviousValuesLog2 + 3 + Traits::kBitsLog2;
+
     constexpr static const int16_t leadingRep_[] = {0, 8, 12, 16, 18, 20, 22, 24};
 
     int storedLeadingZeros_ = std::numeric_limits<int>::max();
 
     int storedTrailingZeros_ = 0;
 
-    uint64_t stored_val_ = 0;
-
-    int previousValues_;
-
-    int previousValuesLog2_;
+    Bits stored_val_ = 0;
 
-    int initialFill_;
+    Bits storedValues_[kPreviousValues] = {};
 
-    Array<uint64_t> storedValues_ = Array<uint64_t>(0);
+    std::unique_ptr<InputBitStream> input_bit_stream_ = std::make_unique<InputBitStream>();
 
-    std::unique_ptr<InputBitStream> input_bit_stream_;
+    bitstream::StreamHeader header_;
 
     int current_ = 0;
 
-    bool first_ = true;
-
-    double nextValue();
+    T nextValue();
 };
 
-#endif //CHIMP_DECOMPRESSOR_H
\ No newline at end of file
+extern template class ChimpNDecompressor<32>;
+extern template class ChimpNDecompressor<64>;
+extern template class ChimpNDecompressor<128>;
+extern template class ChimpNDecompressor<256>;
+extern template class ChimpNDecompressor<32, float>;
+extern template class ChimpNDecompressor<64, float>;
+extern template class ChimpNDecompressor<128, float>;
+extern template class ChimpNDecompressor<256, float>;
+
+using ChimpDecompressor = ChimpNDecompressor<128>;
+using ChimpDecompressor32 = ChimpNDecompressor<128, float>;
+
+#endif //CHIMP_DECOMPRESSOR_H
@@ -0,0 +1,225 @@
+#ifndef CHIMP_MULTI_STREAM_H
+#define CHIMP_MULTI_STREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "array.h"
+#include "bit_reader.h"
+#include "chimp_compressor.h"
+#include "double.h"
+#include "stream_header.h"
+
+// ChimpN over kStreams interleaved sub-streams: value i goes to sub-stream
+// i % kStreams, and each sub-stream is an ordinary ChimpN chain with its own
+// window. A block decodes as kStreams independent dependency chains, which the
+// out-of-order core overlaps.
+//
+//   [StreamHeader][kStreams:1][sub-stream bytes: 4 LE each][sub-streams]
+//   [zero padding: kPadding]
+//
+// A sub-stream is the ChimpN bit stream of its values, without a header.
+template<int kStreams, int kPreviousValues = 128>
+class ChimpMultiStreamCompressor {
+public:
+    static_assert(kStreams > 0 && kStreams < 256, "stream count must fit in a byte");
+
+    // Lets the decoder read 9 bytes at any position of the last sub-stream
+    static constexpr size_t kPadding = 9;
+
+    explicit ChimpMultiStreamCompressor(bool with_stats = false) : header_(with_stats) {
+        for (auto &stream : streams_) {
+            stream = std::make_unique<ChimpNCompressor<kPreviousValues>>();
+        }
+    }
+
+    void addValue(double v) {
+        streams_[next_]->addValue(v);
+        header_.Add(v);
+        if (++next_ == kStreams) next_ = 0;
+    }
+
+    void close() {
+        for (auto &stream : streams_) stream->close();
+    }
+
+    // Starts a new block
+    void reset() {
+        for (auto &stream : streams_) stream->reset();
+        header_.Clear();
+        next_ = 0;
+    }
+
+    Array<uint8_t> get_compress_pack() {
+        Array<uint8_t> packs[kStreams];
+        size_t total = header_.size() + 1 + 4 * kStreams + kPadding;
+        for (int s = 0; s < kStreams; ++s) {
+            packs[s] = streams_[s]->get_compress_pack();
+            total += packs[s].length() - kSubHeaderSize;
+        }
+        compress_pack_ = Array<uint8_t>(static_cast<int>(total));
+        uint8_t *out = compress_pack_.begin();
+        header_.Store(out);
+        out += header_.size();
+        *out++ = kStreams;
+        for (int s = 0; s < kStreams; ++s) {
+            uint32_t bytes = packs[s].length() - kSubHeaderSize;
+            std::memcpy(out, &bytes, sizeof(bytes));
+            out += sizeof(bytes);
+        }
+        for (int s = 0; s < kStreams; ++s) {
+            std::memcpy(out, packs[s].begin() + kSubHeaderSize, packs[s].length() - kSubHeaderSize);
+            out += packs[s].length() - kSubHeaderSize;
+        }
+        return compress_pack_;
+    }
+
+    // The bytes of get_compress_pack(), in bits
+    long get_size() {
+        long bits = (header_.size() + 1 + 4 * kStreams + kPadding) * 8;
+        for (auto &stream : streams_) {
+            bits += (stream->get_size() + 7) / 8 * 8 - kSubHeaderSize * 8;
+        }
+        return bits;
+    }
+
+private:
+    // The header of each sub-stream compressor, which the block header replaces
+    static constexpr size_t kSubHeaderSize = bitstream::StreamHeader::kBaseSize;
+
+    std::unique_ptr<ChimpNCompressor<kPreviousValues>> streams_[kStreams];
+
+    bitstream::StreamHeader header_;
+
+    int next_ = 0;
+
+    Array<uint8_t> compress_pack_ = Array<uint8_t>(0);
+};
+
+template<int kStreams, int kPreviousValues = 128>
+class ChimpMultiStreamDecompressor {
+public:
+    static_assert(kStreams > 0 && kStreams < 256, "stream count must fit in a byte");
+
+    static bitstream::StreamHeader header(const Array<uint8_t> &compress_pack) {
+        return bitstream::StreamHeader::Load(compress_pack.begin(), compress_pack.length());
+    }
+
+    // Writes header(compress_pack).count values to output, returns the count
+    int decompress(const Array<uint8_t> &compress_pack, double *output) {
+        constexpr size_t kPadding = ChimpMultiStreamCompressor<kStreams, kPreviousValues>::kPadding;
+        bitstream::StreamHeader stream_header = header(compress_pack);
+        if (static_cast<size_t>(compress_pack.length()) < stream_header.size() + 1 + 4 * kStreams + kPadding) {
+            throw std::runtime_error("[Chimp Error]: Stream is too short");
+        }
+        const uint8_t *in = compress_pack.begin() + stream_header.size();
+        const uint8_t *end = compress_pack.begin() + compress_pack.length() - kPadding;
+        if (*in != kStreams) throw std::runtime_error("[Chimp Error]: Stream count does not match");
+        // Chains are locals so that the compiler can keep them in registers
+        Chain chains[kStreams];
+        const uint8_t *payload = in + 1 + 4 * kStreams;
+        for (int s = 0; s < kStreams; ++s) {
+            uint32_t bytes;
+            std::memcpy(&bytes, in + 1 + 4 * s, sizeof(bytes));
+            if (payload + bytes > end) throw std::runtime_error("[Chimp Error]: Truncated sub-stream");
+            chains[s].Reset(payload);
+            payload += bytes;
+        }
+
+        int count = static_cast<int>(stream_header.count);
+        int first = count < kStreams ? count : kStreams;
+        for (int s = 0; s < first; ++s) output[s] = chains[s].First();
+        int i = first;
+        // One value from every chain per round
+        for (; i + kStreams <= count; i += kStreams) {
+#pragma GCC unroll 16
+            for (int s = 0; s < kStreams; ++s) output[i + s] = chains[s].Next();
+        }
+        for (int s = 0; i < count; ++s, ++i) output[i] = chains[s].Next();
+        return count;
+    }
+
+    std::vector<double> decompress(const Array<uint8_t> &compress_pack) {
+        std::vector<double> values(header(compress_pack).count);
+        decompress(compress_pack, values.data());
+        return values;
+    }
+
+private:
+    static constexpr int kPreviousValuesLog2 = __builtin_ctz(kPreviousValues);
+
+    static constexpr int kRingMask = kPreviousValues - 1;
+
+    static constexpr int kInitialFill = kPreviousValuesLog2 + 9;
+
+    // ChimpNDecompressor::nextValue, with its own reader: the block padding
+    // lets every read be one unaligned load plus a byte, without bounds
+    // checks. It selects on the flag instead of branching: those branches
+    // mispredict often, and every miss would also flush the other chains of
+    // the round.
+    struct Chain {
+        const uint8_t *data = nullptr;
+        size_t pos = 0;
+        uint64_t stored_val = 0;
+        int storedLeadingZeros = 0;
+        int current = 0;
+        uint64_t storedValues[kPreviousValues];
+
+        void Reset(const uint8_t *new_data) {
+            data = new_data;
+            pos = 0;
+            stored_val = 0;
+            storedLeadingZeros = 0;
+            current = 0;
+        }
+
+        double First() {
+            stored_val = Peek64(data, pos);
+            pos += 64;
+            storedValues[current] = stored_val;
+            return Double::LongBitsToDouble(stored_val);
+        }
+
+        BITSTREAM_INLINE double Next() {
+            static constexpr int16_t kLeadingRep[] = {0, 8, 12, 16, 18, 20, 22, 24};
+            static constexpr int kControlBits[] = {2 + kPreviousValuesLog2, 2 + kInitialFill, 2, 5};
+            // flag:2, then for '11' lead:3, for '01' index + lead:3 +
+            // significant bits:6, for '00' index
+            uint32_t control = static_cast<uint32_t>(Peek64(data, pos) >> (62 - kInitialFill));
+            uint32_t flag = control >> kInitialFill;
+            int index = static_cast<int>(control >> (kInitialFill - kPreviousValuesLog2)) & kRingMask;
+            int lead = kLeadingRep[(control >> (kInitialFill - 3)) & 0x7];
+            int significant_bits = static_cast<int>(control & 0x3f);
+            significant_bits = significant_bits == 0 ? 64 : significant_bits;
+            if (flag == 1) {
+                index = static_cast<int>(control >> 9) & kRingMask;
+                lead = kLeadingRep[(control >> 6) & 0x7];
+            }
+            uint64_t reference = flag >= 2 ? stored_val : storedValues[index];
+            storedLeadingZeros = flag == 3 || flag == 1 ? lead : storedLeadingZeros;
+            int len = flag >= 2 ? 64 - storedLeadingZeros : flag == 1 ? significant_bits : 0;
+            int shift = flag == 1 ? 64 - significant_bits - lead : 0;
+            pos += kControlBits[flag];
+            uint64_t bits = Peek64(data, pos);
+            bits = len == 0 ? 0 : bits >> (64 - len);
+            pos += len;
+            stored_val = reference ^ (bits << shift);
+            current = (current + 1) & kRingMask;
+            storedValues[current] = stored_val;
+            return Double::LongBitsToDouble(stored_val);
+        }
+    };
+
+    // The 64 bits at bit position pos
+    BITSTREAM_INLINE static uint64_t Peek64(const uint8_t *data, size_t pos) {
+        const uint8_t *byte = data + (pos >> 3);
+        int shift = static_cast<int>(pos & 7);
+        return (bitstream::LoadBigEndian64(byte) << shift) | (static_cast<uint64_t>(byte[8]) >> (8 - shift));
+    }
+};
+
+#endif // CHIMP_MULTI_STREAM_H
@@ -0,0 +1,438 @@
+#include "chunk_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "alp.hpp"
+#include "../chimp128/chimp_compressor.h"
+#include "../chimp128/chimp_decompressor.h"
+#include "../elf/elf.h"
+#include "../fpc/fpc_compressor.h"
+#include "../fpc/fpc_decompressor.h"
+#include "../gorilla/gorilla_compressor.h"
+#include "../gorilla/gorilla_decompressor.h"
+#include "../machete/machete.h"
+#include "../sim_piece/sim_piece.h"
+#include "../sz2/sz/include/sz.h"
+
+namespace {
+
+// FPC table size, as in the benchmarks
+constexpr long kFpcPredictorBits = 5;
+
+// Lossy codecs get a slightly tighter bound, as in the benchmarks: SZ2,
+// Machete and SimPiece may overshoot theirs by rounding
+constexpr double kLossyMargin = 0.99;
+
+template<typename T>
+void Store(uint8_t *&dst, T value) {
+    std::memcpy(dst, &value, sizeof(T));
+    dst += sizeof(T);
+}
+
+template<typename T>
+T Load(const uint8_t *&src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    src += sizeof(T);
+    return value;
+}
+
+std::vector<uint8_t> ToBytes(ChunkCodec codec, const uint8_t *payload, size_t length) {
+    std::vector<uint8_t> block(length + 1);
+    block[0] = static_cast<uint8_t>(codec);
+    std::memcpy(block.data() + 1, payload, length);
+    return block;
+}
+
+// For the codecs whose stream does not start with its value count
+std::vector<uint8_t> ToCountedBytes(ChunkCodec codec, uint32_t count, const uint8_t *payload, size_t length) {
+    std::vector<uint8_t> block(1 + sizeof(count) + length);
+    block[0] = static_cast<uint8_t>(codec);
+    std::memcpy(block.data() + 1, &count, sizeof(count));
+    std::memcpy(block.data() + 1 + sizeof(count), payload, length);
+    return block;
+}
+
+// Checks the count a payload starts with before anything is decoded into the
+// rows values of the caller
+void CheckCount(const uint8_t *payload, size_t payload_length, uint32_t rows) {
+    if (payload_length < sizeof(uint32_t)) throw std::runtime_error("[ChunkFile Error]: Truncated block");
+    uint32_t count;
+    std::memcpy(&count, payload, sizeof(count));
+    if (count != rows) throw std::runtime_error("[ChunkFile Error]: Block count does not match its rows");
+}
+
+Array<uint8_t> ToArray(const uint8_t *payload, size_t length) {
+    Array<uint8_t> array(static_cast<int>(length));
+    std::memcpy(array.begin(), payload, length);
+    return array;
+}
+
+}  // namespace
+
+constexpr char ChunkFile::kMagic[4];
+
+const char *ChunkCodecName(ChunkCodec codec) {
+    switch (codec) {
+        case ChunkCodec::kRaw: return "Raw";
+        case ChunkCodec::kGorilla: return "Gorilla";
+        case ChunkCodec::kChimp128: return "Chimp128";
+        case ChunkCodec::kFpc: return "FPC";
+        case ChunkCodec::kElf: return "Elf";
+        case ChunkCodec::kAlp: return "ALP";
+        case ChunkCodec::kSz2: return "SZ2";
+        case ChunkCodec::kMachete: return "Machete";
+        case ChunkCodec::kSimPiece: return "SimPiece";
+    }
+    return "Unknown";
+}
+
+bool ChunkCodecIsLossy(ChunkCodec codec) {
+    return codec == ChunkCodec::kSz2 || codec == ChunkCodec::kMachete || codec == ChunkCodec::kSimPiece;
+}
+
+std::vector<uint8_t> ChunkFile::EncodeBlock(ChunkCodec codec, const double *values, int count,
+                                            double error_bound) {
+    if (ChunkCodecIsLossy(codec) && !(error_bound > 0)) {
+        throw std::runtime_error("[ChunkFile Error]: A lossy codec needs a positive error bound");
+    }
+    switch (codec) {
+        case ChunkCodec::kRaw:
+            return ToBytes(codec, reinterpret_cast<const uint8_t *>(values), count * sizeof(double));
+        case ChunkCodec::kGorilla: {
+            GorillaCompressor compressor(count);
+            for (int i = 0; i < count; ++i) compressor.addValue(values[i]);
+            compressor.close();
+            Array<uint8_t> pack = compressor.get_compress_pack();
+            return ToBytes(codec, pack.begin(), pack.length());
+        }
+        case ChunkCodec::kChimp128: {
+            ChimpCompressor compressor;
+            for (int i = 0; i < count; ++i) compressor.addValue(values[i]);
+            compressor.close();
+            Array<uint8_t> pack = compressor.get_compress_pack();
+            return ToBytes(codec, pack.begin(), pack.length());
+        }
+        case ChunkCodec::kFpc: {
+            FpcCompressor compressor(kFpcPredictorBits, count);
+            for (int i = 0; i < count; ++i) compressor.addValue(values[i]);
+            compressor.close();
+            std::vector<char> bytes = compressor.getBytes();
+            return ToCountedBytes(codec, count, reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size());
+        }
+        case ChunkCodec::kElf: {
+            uint8_t *bytes;
+            ssize_t length = elf_encode(const_cast<double *>(values), count, &bytes, 0);
+            std::vector<uint8_t> block = ToBytes(codec, bytes, length);
+            free(bytes);
+            return block;
+        }
+        case ChunkCodec::kAlp: {
+            // ALP stores whole vectors, and an exception costs more than a raw value
+            size_t vector_values = alp::AlpApiUtils<double>::align_value<size_t, alp::config::VECTOR_SIZE>(count);
+            std::vector<uint8_t> bytes(vector_values * 2 * sizeof(double) + 1024);
+            alp::AlpCompressor<double> compressor;
+            compressor.compress(const_cast<double *>(values), count, bytes.data());
+            return ToCountedBytes(codec, count, bytes.data(), compressor.get_size());
+        }
+        case ChunkCodec::kSz2: {
+            size_t length;
+            unsigned char *bytes = SZ_compress_args(SZ_DOUBLE, const_cast<double *>(values), &length, ABS,
+                                                   error_bound * kLossyMargin, 0, 0, 0, 0, 0, 0, count);
+            std::vector<uint8_t> block = ToCountedBytes(codec, count, bytes, length);
+            free(bytes);
+            return block;
+        }
+        case ChunkCodec::kMachete: {
+            uint8_t *bytes;
+            ssize_t length = machete_compress<lorenzo1, hybrid>(const_cast<double *>(values), count, &bytes,
+                                                                error_bound * kLossyMargin);
+            std::vector<uint8_t> block = ToBytes(codec, bytes, length);
+            free(bytes);
+            return block;
+        }
+        case ChunkCodec::kSimPiece: {
+            std::vector<Point> points;
+            points.reserve(count);
+            for (int i = 0; i < count; ++i) points.emplace_back(i, values[i]);
+            SimPiece sim_piece(points, error_bound * kLossyMargin);
+            std::vector<char> bytes(sim_piece.maxByteArraySize());
+            int timestamp_store_size;
+            int length = sim_piece.toByteArray(bytes.data(), true, &timestamp_store_size);
+            return ToBytes(codec, reinterpret_cast<const uint8_t *>(bytes.data()), length);
+        }
+    }
+    throw std::runtime_error("[ChunkFile Error]: Unknown codec");
+}
+
+void ChunkFile::DecodeBlock(const uint8_t *block, size_t length, uint32_t rows, double *output) {
+    if (length == 0) throw std::runtime_error("[ChunkFile Error]: Empty block");
+    auto codec = static_cast<ChunkCodec>(block[0]);
+    const uint8_t *payload = block + 1;
+    size_t payload_length = length - 1;
+    switch (codec) {
+        case ChunkCodec::kRaw:
+            if (payload_length != rows * sizeof(double)) {
+                throw std::runtime_error("[ChunkFile Error]: Raw block size does not match its rows");
+            }
+            std::memcpy(output, payload, payload_length);
+            return;
+        case ChunkCodec::kGorilla: {
+            GorillaDecompressor decompressor;
+            Array<uint8_t> pack = ToArray(payload, payload_length);
+            if (GorillaDecompressor::header(pack).count != rows) {
+                throw std::runtime_error("[ChunkFile Error]: Block count does not match its rows");
+            }
+            decompressor.decompress(pack, output);
+            return;
+        }
+        case ChunkCodec::kChimp128: {
+            ChimpDecompressor decompressor(ToArray(payload, payload_length));
+            if (decompressor.header().count != rows) {
+                throw std::runtime_error("[ChunkFile Error]: Block count does not match its rows");
+            }
+            decompressor.decompress(output);
+            return;
+        }
+        case ChunkCodec::kFpc: {
+            CheckCount(payload, payload_length, rows);
+            FpcDecompressor decompressor(kFpcPredictorBits, rows);
+            decompressor.setBytes(reinterpret_cast<char *>(const_cast<uint8_t *>(payload + sizeof(uint32_t))),
+                                  payload_length - sizeof(uint32_t));
+            decompressor.decompress(output);
+            return;
+        }
+        case ChunkCodec::kElf: {
+            // Elf's own stream starts with the count
+            CheckCount(payload, payload_length, rows);
+            elf_decode(const_cast<uint8_t *>(payload), payload_length, output, 0);
+            return;
+        }
+        case ChunkCodec::kAlp: {
+            CheckCount(payload, payload_length, rows);
+            // ALP decodes whole vectors
+            std::vector<double> values(alp::AlpApiUtils<double>::align_value<size_t, alp::config::VECTOR_SIZE>(rows));
+            alp::AlpDecompressor<double> decompressor;
+            decompressor.decompress(const_cast<uint8_t *>(payload + sizeof(uint32_t)), rows, values.data());
+            std::memcpy(output, values.data(), rows * sizeof(double));
+            return;
+        }
+        case ChunkCodec::kSz2: {
+            // SZ copies as many values as it is asked for, whatever its stream holds
+            CheckCount(payload, payload_length, rows);
+            SZ_decompress_args(SZ_DOUBLE, const_cast<uint8_t *>(payload + sizeof(uint32_t)),
+                               payload_length - sizeof(uint32_t), output, 0, 0, 0, 0, rows);
+            return;
+        }
+        case ChunkCodec::kMachete: {
+            // Machete's own stream starts with the count
+            CheckCount(payload, payload_length, rows);
+            machete_decompress<lorenzo1, hybrid>(const_cast<uint8_t *>(payload), payload_length, output);
+            return;
+        }
+        case ChunkCodec::kSimPiece: {
+            SimPiece sim_piece(reinterpret_cast<char *>(const_cast<uint8_t *>(payload)),
+                               static_cast<int>(payload_length), true);
+            std::vector<Point> points = sim_piece.decompress();
+            if (points.size() != rows) throw std::runtime_error("[ChunkFile Error]: Block count does not match its rows");
+            for (uint32_t i = 0; i < rows; ++i) output[i] = points[i].getValue();
+            return;
+        }
+    }
+    throw std::runtime_error("[ChunkFile Error]: Unknown codec");
+}
+
+ChunkFileWriter::ChunkFileWriter(const std::string &path) : output_(path, std::ios::binary | std::ios::trunc) {
+    if (!output_.is_open()) throw std::runtime_error("[ChunkFile Error]: Cannot create " + path);
+    uint8_t header[ChunkFile::kHeaderSize] = {};
+    std::memcpy(header, ChunkFile::kMagic, sizeof(ChunkFile::kMagic));
+    header[4] = ChunkFile::kVersion;
+    Write(header, sizeof(header));
+}
+
+ChunkFileWriter::~ChunkFileWriter() {
+    if (closed_) return;
+    try {
+        Close();
+    } catch (const std::exception &) {
+    }
+}
+
+void ChunkFileWriter::Write(const void *data, size_t size) {
+    output_.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+    if (!output_) throw std::runtime_error("[ChunkFile Error]: Write failed");
+    offset_ += size;
+}
+
+void ChunkFileWriter::Append(const double *values, int count, ChunkCodec codec, double error_bound) {
+    if (closed_) throw std::runtime_error("[ChunkFile Error]: Writer is closed");
+    if (count <= 0) throw std::runtime_error("[ChunkFile Error]: Empty block");
+    std::vector<uint8_t> block = ChunkFile::EncodeBlock(codec, values, count, error_bound);
+    if (block.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("[ChunkFile Error]: Block is too large");
+    }
+
+    ChunkIndexEntry entry;
+    entry.first_row = row_count_;
+    entry.offset = offset_;
+    entry.length = static_cast<uint32_t>(block.size());
+    entry.rows = static_cast<uint32_t>(count);
+    entry.min = std::numeric_limits<double>::infinity();
+    entry.max = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < count; ++i) {
+        entry.min = std::fmin(entry.min, values[i]);
+        entry.max = std::fmax(entry.max, values[i]);
+    }
+    entry.codec = codec;
+
+    Write(block.data(), block.size());
+    index_.push_back(entry);
+    row_count_ += count;
+}
+
+void ChunkFileWriter::Close() {
+    if (closed_) return;
+    closed_ = true;
+    std::vector<uint8_t> footer(index_.size() * ChunkFile::kEntrySize + ChunkFile::kTrailerSize);
+    uint8_t *out = footer.data();
+    for (const auto &entry : index_) {
+        Store(out, entry.first_row);
+        Store(out, entry.offset);
+        Store(out, entry.length);
+        Store(out, entry.rows);
+        Store(out, entry.min);
+        Store(out, entry.max);
+        Store(out, static_cast<uint8_t>(entry.codec));
+    }
+    Store(out, offset_);
+    Store(out, static_cast<uint32_t>(index_.size()));
+    std::memcpy(out, ChunkFile::kMagic, sizeof(ChunkFile::kMagic));
+    Write(footer.data(), footer.size());
+    output_.close();
+    if (!output_) throw std::runtime_error("[ChunkFile Error]: Close failed");
+}
+
+ChunkFileReader::ChunkFileReader(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("[ChunkFile Error]: Cannot open " + path);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw std::runtime_error("[ChunkFile Error]: Cannot stat " + path);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ < ChunkFile::kHeaderSize + ChunkFile::kTrailerSize) {
+        close(fd);
+        throw std::runtime_error("[ChunkFile Error]: File is too short");
+    }
+    void *mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) throw std::runtime_error("[ChunkFile Error]: Cannot map " + path);
+    data_ = static_cast<const uint8_t *>(mapped);
+
+    try {
+        if (std::memcmp(data_, ChunkFile::kMagic, sizeof(ChunkFile::kMagic)) != 0 ||
+            std::memcmp(data_ + size_ - sizeof(ChunkFile::kMagic), ChunkFile::kMagic,
+                        sizeof(ChunkFile::kMagic)) != 0) {
+            throw std::runtime_error("[ChunkFile Error]: Not a chunk file");
+        }
+        if (data_[4] != ChunkFile::kVersion) throw std::runtime_error("[ChunkFile Error]: Unknown version");
+
+        const uint8_t *trailer = data_ + size_ - ChunkFile::kTrailerSize;
+        auto footer_offset = Load<uint64_t>(trailer);
+        auto block_count = Load<uint32_t>(trailer);
+        // Subtractions only: the trailer may hold anything
+        size_t footer_end = size_ - ChunkFile::kTrailerSize;
+        if (footer_offset < ChunkFile::kHeaderSize || footer_offset > footer_end ||
+            (footer_end - footer_offset) % ChunkFile::kEntrySize != 0 ||
+            block_count != (footer_end - footer_offset) / ChunkFile::kEntrySize) {
+            throw std::runtime_error("[ChunkFile Error]: Corrupt footer");
+        }
+
+        const uint8_t *in = data_ + footer_offset;
+        index_.resize(block_count);
+        for (auto &entry : index_) {
+            entry.first_row = Load<uint64_t>(in);
+            entry.offset = Load<uint64_t>(in);
+            entry.length = Load<uint32_t>(in);
+            entry.rows = Load<uint32_t>(in);
+            entry.min = Load<double>(in);
+            entry.max = Load<double>(in);
+            entry.codec = static_cast<ChunkCodec>(Load<uint8_t>(in));
+            if (entry.first_row != row_count_ || entry.offset < ChunkFile::kHeaderSize ||
+                entry.offset > footer_offset || entry.length > footer_offset - entry.offset || entry.length == 0 ||
+                data_[entry.offset] != static_cast<uint8_t>(entry.codec)) {
+                throw std::runtime_error("[ChunkFile Error]: Corrupt index entry");
+            }
+            row_count_ += entry.rows;
+        }
+    } catch (...) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+        throw;
+    }
+}
+
+ChunkFileReader::~ChunkFileReader() {
+    munmap(const_cast<uint8_t *>(data_), size_);
+}
+
+size_t ChunkFileReader::FindBlock(uint64_t row) const {
+    if (row >= row_count_) throw std::runtime_error("[ChunkFile Error]: Row out of range");
+    auto next = std::upper_bound(index_.begin(), index_.end(), row,
+                                 [](uint64_t r, const ChunkIndexEntry &entry) { return r < entry.first_row; });
+    return static_cast<size_t>(next - index_.begin()) - 1;
+}
+
+uint32_t ChunkFileReader::ReadBlock(size_t block, double *output) const {
+    if (block >= index_.size()) throw std::runtime_error("[ChunkFile Error]: Block out of range");
+    const ChunkIndexEntry &entry = index_[block];
+    ChunkFile::DecodeBlock(data_ + entry.offset, entry.length, entry.rows, output);
+    return entry.rows;
+}
+
+std::vector<double> ChunkFileReader::ReadBlock(size_t block) const {
+    if (block >= index_.size()) throw std::runtime_error("[ChunkFile Error]: Block out of range");
+    std::vector<double> values(index_[block].rows);
+    ReadBlock(block, values.data());
+    return values;
+}
+
+void ChunkFileReader::ReadRows(uint64_t first_row, uint64_t count, double *output) const {
+    if (count == 0) return;
+    if (first_row + count > row_count_ || first_row + count < first_row) {
+        throw std::runtime_error("[ChunkFile Error]: Rows out of range");
+    }
+    uint64_t end_row = first_row + count;
+    std::vector<double> scratch;
+    for (size_t block = FindBlock(first_row); block < index_.size() && index_[block].first_row < end_row;
+         ++block) {
+        const ChunkIndexEntry &entry = index_[block];
+        uint64_t from = std::max(first_row, entry.first_row);
+        uint64_t to = std::min(end_row, entry.first_row + entry.rows);
+        double *dst = output + (from - first_row);
+        if (from == entry.first_row && to == entry.first_row + entry.rows) {
+            // The whole block is wanted: decode in place
+            ReadBlock(block, dst);
+        } else {
+            scratch.resize(entry.rows);
+            ReadBlock(block, scratch.data());
+            std::copy(scratch.begin() + (from - entry.first_row), scratch.begin() + (to - entry.first_row), dst);
+        }
+    }
+}
+
+std::vector<double> ChunkFileReader::ReadRows(uint64_t first_row, uint64_t count) const {
+    std::vector<double> values(count);
+    ReadRows(first_row, count, values.data());
+    return values;
+}
@@ -0,0 +1,171 @@
+#ifndef CHUNK_FILE_H
+#define CHUNK_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// A file of compressed blocks of one double series, with an index in a footer
+// so that a reader can decode any block or row range on its own.
+//
+//   header:  [magic "FCCF":4][version:1][reserved:3]
+//   blocks:  [codec:1][codec payload] ...
+//   footer:  [entry: kEntrySize] x block count
+//   trailer: [footer offset:8][block count:4][magic "FCCF":4]
+//
+//   entry:   [first row:8][offset:8][length:4][rows:4][min:8][max:8][codec:1]
+//
+// The payloads of FPC, ALP and SZ2 start with [count:4]. The other codecs
+// carry their count in their own streams, so every block is checked against
+// its rows before any value is decoded.
+//
+// Integers and doubles are little endian. An entry's offset and length cover
+// the whole block, codec byte included. min/max are those of the appended
+// values, before a lossy codec, and leave out NaNs; a block of NaNs only has
+// min = +inf and max = -inf.
+
+// Block codecs. The ids are stored in the file, so they never change.
+enum class ChunkCodec : uint8_t {
+    kRaw = 0,
+    kGorilla = 1,
+    kChimp128 = 2,
+    kFpc = 3,
+    kElf = 4,
+    kAlp = 5,
+    // Lossy, within the error bound given to EncodeBlock
+    kSz2 = 6,
+    kMachete = 7,
+    kSimPiece = 8,
+};
+
+bool ChunkCodecIsLossy(ChunkCodec codec);
+
+const char *ChunkCodecName(ChunkCodec codec);
+
+struct ChunkIndexEntry {
+    uint64_t first_row = 0;
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    uint32_t rows = 0;
+    double min = 0;
+    double max = 0;
+    ChunkCodec codec = ChunkCodec::kRaw;
+};
+
+class ChunkFile {
+public:
+    static constexpr char kMagic[4] = {'F', 'C', 'C', 'F'};
+
+    static constexpr uint8_t kVersion = 2;
+
+    static constexpr size_t kHeaderSize = 8;
+
+    static constexpr size_t kEntrySize = 41;
+
+    static constexpr size_t kTrailerSize = 16;
+
+    // Compresses count values with codec, codec byte first. error_bound is the
+    // absolute error a lossy codec may make and must then be positive.
+    static std::vector<uint8_t> EncodeBlock(ChunkCodec codec, const double *values, int count,
+                                            double error_bound = 0);
+
+    // Decodes a block of EncodeBlock into rows values. Throws without writing
+    // to output when the block holds another number of values.
+    static void DecodeBlock(const uint8_t *block, size_t length, uint32_t rows, double *output);
+};
+
+// Appends blocks to a new chunk file. Close() writes the footer; a writer
+// destroyed without Close() closes the file itself, ignoring errors.
+class ChunkFileWriter {
+public:
+    explicit ChunkFileWriter(const std::string &path);
+
+    ~ChunkFileWriter();
+
+    ChunkFileWriter(const ChunkFileWriter &) = delete;
+
+    ChunkFileWriter &operator=(const ChunkFileWriter &) = delete;
+
+    // Compresses count values into the next block
+    void Append(const double *values, int count, ChunkCodec codec, double error_bound = 0);
+
+    void Close();
+
+    uint64_t row_count() const {
+        return row_count_;
+    }
+
+    size_t block_count() const {
+        return index_.size();
+    }
+
+    // Bytes written so far
+    uint64_t size() const {
+        return offset_;
+    }
+
+private:
+    void Write(const void *data, size_t size);
+
+    std::ofstream output_;
+
+    std::vector<ChunkIndexEntry> index_;
+
+    uint64_t offset_ = 0;
+
+    uint64_t row_count_ = 0;
+
+    bool closed_ = false;
+};
+
+// Maps a chunk file read-only. Only the trailer and the footer are read up
+// front; a block is touched when it is decoded.
+class ChunkFileReader {
+public:
+    explicit ChunkFileReader(const std::string &path);
+
+    ~ChunkFileReader();
+
+    ChunkFileReader(const ChunkFileReader &) = delete;
+
+    ChunkFileReader &operator=(const ChunkFileReader &) = delete;
+
+    size_t block_count() const {
+        return index_.size();
+    }
+
+    uint64_t row_count() const {
+        return row_count_;
+    }
+
+    const std::vector<ChunkIndexEntry> &index() const {
+        return index_;
+    }
+
+    // The block holding row, which must be below row_count()
+    size_t FindBlock(uint64_t row) const;
+
+    // Writes the rows of a block to output, returns their count
+    uint32_t ReadBlock(size_t block, double *output) const;
+
+    std::vector<double> ReadBlock(size_t block) const;
+
+    // Writes rows [first_row, first_row + count) to output, decoding only the
+    // blocks that overlap them
+    void ReadRows(uint64_t first_row, uint64_t count, double *output) const;
+
+    std::vector<double> ReadRows(uint64_t first_row, uint64_t count) const;
+
+private:
+    const uint8_t *data_ = nullptr;
+
+    size_t size_ = 0;
+
+    std::vector<ChunkIndexEntry> index_;
+
+    uint64_t row_count_ = 0;
+};
+
+#endif // CHUNK_FILE_H
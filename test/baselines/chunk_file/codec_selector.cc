@@ -0,0 +1,154 @@
+#include "codec_selector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "alp.hpp"
+
+namespace {
+
+// Weight of the newest measurement in the smoothed estimates
+constexpr double kSmoothing = 0.25;
+
+// What an ALP vector stores besides its packed values: exponent, factor,
+// exception count, frame of reference and bit width
+constexpr double kAlpVectorHeaderBytes = 13;
+
+constexpr double kAlpExceptionBytes = sizeof(double) + sizeof(uint16_t);
+
+std::vector<ChunkCodec> DefaultCandidates(const ChunkCostModel &model) {
+    std::vector<ChunkCodec> candidates = {ChunkCodec::kRaw, ChunkCodec::kGorilla, ChunkCodec::kChimp128,
+                                          ChunkCodec::kFpc, ChunkCodec::kElf, ChunkCodec::kAlp};
+    if (model.error_bound > 0) {
+        candidates.push_back(ChunkCodec::kSz2);
+        candidates.push_back(ChunkCodec::kMachete);
+        candidates.push_back(ChunkCodec::kSimPiece);
+    }
+    return candidates;
+}
+
+double MegabytesPerSecond(int count, std::chrono::steady_clock::duration elapsed) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return count * sizeof(double) * 1e3 / std::max<long>(ns, 1);
+}
+
+double Smooth(double previous, double current) {
+    return previous == 0 ? current : previous + kSmoothing * (current - previous);
+}
+
+}  // namespace
+
+ChunkCodecSelector::ChunkCodecSelector(const ChunkCostModel &model)
+        : ChunkCodecSelector(model, DefaultCandidates(model)) {}
+
+ChunkCodecSelector::ChunkCodecSelector(const ChunkCostModel &model, const std::vector<ChunkCodec> &candidates)
+        : model_(model) {
+    if (candidates.empty()) throw std::runtime_error("[ChunkFile Error]: No candidate codec");
+    for (ChunkCodec codec : candidates) {
+        if (ChunkCodecIsLossy(codec) && !(model.error_bound > 0)) {
+            throw std::runtime_error("[ChunkFile Error]: A lossy codec needs a positive error bound");
+        }
+        estimates_.push_back({codec});
+    }
+}
+
+double ChunkCodecSelector::SampleBytesPerValue(ChunkCodec codec, const double *values, int count,
+                                               const double *sample, int sample_count) const {
+    if (codec != ChunkCodec::kAlp || alp_combination_.empty()) {
+        return static_cast<double>(ChunkFile::EncodeBlock(codec, sample, sample_count, model_.error_bound).size()) /
+               sample_count;
+    }
+    // The bit width and exception rate under the calibrated exponent and
+    // factor, as ALP's own sampler estimates them. That is cheap enough to
+    // run on the whole block.
+    int exponent = alp_combination_[0].first;
+    int factor = alp_combination_[0].second;
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+    int exceptions = 0;
+    for (int i = 0; i < count; ++i) {
+        int64_t encoded = alp::AlpEncode<double>::encode_value(values[i], factor, exponent);
+        if (alp::AlpDecode<double>::decode_value(encoded, factor, exponent) != values[i]) {
+            ++exceptions;
+            continue;
+        }
+        min = std::min(min, encoded);
+        max = std::max(max, encoded);
+    }
+    // The encoded values may span more than int64_t holds
+    uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+    double bit_width = exceptions == count ? 0 : std::ceil(std::log2(static_cast<double>(range) + 1));
+    double vectors = std::ceil(static_cast<double>(count) / alp::config::VECTOR_SIZE);
+    double bytes = vectors * (kAlpVectorHeaderBytes + bit_width * alp::config::VECTOR_SIZE / 8) +
+                   kAlpExceptionBytes * exceptions;
+    return bytes / count;
+}
+
+void ChunkCodecSelector::Calibrate(const double *values, int count) {
+    alp::state state;
+    std::vector<double> alp_sample(alp::config::VECTOR_SIZE);
+    alp::AlpEncode<double>::init(values, 0, count, alp_sample.data(), state);
+    alp_combination_.clear();
+    if (state.scheme == alp::SCHEME::ALP && !state.best_k_combinations.empty()) {
+        alp_combination_.push_back(state.best_k_combinations[0]);
+    }
+
+    decoded_.resize(count);
+    for (auto &estimate : estimates_) {
+        auto encode_start_time = std::chrono::steady_clock::now();
+        std::vector<uint8_t> block = ChunkFile::EncodeBlock(estimate.codec, values, count, model_.error_bound);
+        auto encode_end_time = std::chrono::steady_clock::now();
+        ChunkFile::DecodeBlock(block.data(), block.size(), count, decoded_.data());
+        auto decode_end_time = std::chrono::steady_clock::now();
+        estimate.encode_mb_per_s = Smooth(estimate.encode_mb_per_s,
+                                          MegabytesPerSecond(count, encode_end_time - encode_start_time));
+        estimate.decode_mb_per_s = Smooth(estimate.decode_mb_per_s,
+                                          MegabytesPerSecond(count, decode_end_time - encode_end_time));
+        estimate.bytes_per_value = static_cast<double>(block.size()) / count;
+    }
+}
+
+ChunkCodec ChunkCodecSelector::Select(const double *values, int count) {
+    if (count <= 0) throw std::runtime_error("[ChunkFile Error]: Empty block");
+    bool calibrate = selections_++ % kCalibrationPeriod == 0;
+    if (calibrate) Calibrate(values, count);
+
+    // Runs rather than single values: the XOR and delta codecs live on
+    // neighbouring values
+    const double *sample = values;
+    int sample_count = count;
+    if (count > kSampleRuns * kSampleRunLength) {
+        sample_.resize(kSampleRuns * kSampleRunLength);
+        int stride = (count - kSampleRunLength) / (kSampleRuns - 1);
+        for (int run = 0; run < kSampleRuns; ++run) {
+            std::copy(values + run * stride, values + run * stride + kSampleRunLength,
+                      sample_.begin() + run * kSampleRunLength);
+        }
+        sample = sample_.data();
+        sample_count = static_cast<int>(sample_.size());
+    }
+
+    for (auto &estimate : estimates_) {
+        double sample_bytes_per_value = SampleBytesPerValue(estimate.codec, values, count, sample,
+                                                             sample_count);
+        if (calibrate) {
+            // bytes_per_value is exact here, from Calibrate()
+            estimate.correction = Smooth(estimate.correction, estimate.bytes_per_value / sample_bytes_per_value);
+        } else {
+            estimate.bytes_per_value = sample_bytes_per_value * estimate.correction;
+        }
+    }
+
+    const Estimate *best = nullptr;
+    for (const auto &estimate : estimates_) {
+        if (estimate.encode_mb_per_s < model_.min_encode_mb_per_s ||
+            estimate.decode_mb_per_s < model_.min_decode_mb_per_s) {
+            continue;
+        }
+        if (best == nullptr || estimate.bytes_per_value < best->bytes_per_value) best = &estimate;
+    }
+    return best == nullptr ? ChunkCodec::kRaw : best->codec;
+}
@@ -0,0 +1,89 @@
+#ifndef CHUNK_CODEC_SELECTOR_H
+#define CHUNK_CODEC_SELECTOR_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "chunk_file.h"
+
+// What the codec of a block may cost. Throughputs are in MB of doubles per
+// second, 0 for no limit.
+struct ChunkCostModel {
+    // Lossy codecs are candidates only with a positive bound
+    double error_bound = 0;
+
+    double min_encode_mb_per_s = 0;
+
+    double min_decode_mb_per_s = 0;
+};
+
+// Picks the codec of each block from a sample of it: kSampleRuns runs of
+// kSampleRunLength consecutive values, spread over the block, are compressed
+// with every candidate. The codec with the fewest estimated bytes among those
+// meeting the throughput limits wins, Raw if none does.
+//
+// Every kCalibrationPeriod blocks, starting with the first, the whole block
+// is compressed and decompressed with every candidate instead. That measures
+// the throughputs, and corrects the sample estimates of each codec for what a
+// short sample gets wrong (fixed headers, tables, context). ALP is not run on
+// the sample, since it always packs a full vector: its estimate comes from
+// the exponent and factor ALP chose at the last calibration, applied to the
+// block.
+class ChunkCodecSelector {
+public:
+    static constexpr int kSampleRuns = 4;
+
+    static constexpr int kSampleRunLength = 32;
+
+    static constexpr int kCalibrationPeriod = 16;
+
+    struct Estimate {
+        ChunkCodec codec;
+        double bytes_per_value = 0;
+        double encode_mb_per_s = 0;
+        double decode_mb_per_s = 0;
+        // Block bytes over sample estimate, smoothed over calibrations
+        double correction = 0;
+    };
+
+    // The lossless codecs, plus the lossy ones when model has an error bound
+    explicit ChunkCodecSelector(const ChunkCostModel &model);
+
+    ChunkCodecSelector(const ChunkCostModel &model, const std::vector<ChunkCodec> &candidates);
+
+    // The codec for a block of count values
+    ChunkCodec Select(const double *values, int count);
+
+    const ChunkCostModel &model() const {
+        return model_;
+    }
+
+    // The estimates of the last Select(), one per candidate
+    const std::vector<Estimate> &estimates() const {
+        return estimates_;
+    }
+
+private:
+    // Bytes per value of codec on the block, estimated from the sample, before
+    // correction
+    double SampleBytesPerValue(ChunkCodec codec, const double *values, int count, const double *sample,
+                               int sample_count) const;
+
+    void Calibrate(const double *values, int count);
+
+    ChunkCostModel model_;
+
+    std::vector<Estimate> estimates_;
+
+    std::vector<double> sample_;
+
+    std::vector<double> decoded_;
+
+    uint64_t selections_ = 0;
+
+    // ALP (exponent, factor) of the last calibration, none if ALP chose ALP_RD
+    std::vector<std::pair<int, int>> alp_combination_;
+};
+
+#endif // CHUNK_CODEC_SELECTOR_H
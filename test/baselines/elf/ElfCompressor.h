@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "ElfTraits.h"
+#include "bit_writer.h"
+
+// Elf encoder as a compile-time pipeline: ElfCompressor (erasure stage) feeds
+// ElfXORCompressor (XOR stage), which writes to a bit sink. Every stage is a
+// template parameter of the one before it, so the per-value calls inline and
+// the same code serves double and float.
+
+template<typename T, typename Sink = bitstream::BitWriter>
+class ElfXORCompressor {
+ public:
+  using Traits = ElfTraits<T>;
+  using Bits = typename Traits::Bits;
+
+  explicit ElfXORCompressor(Sink &sink) : sink_(sink) {}
+
+  // Returns the number of bits written
+  int addValue(Bits value) {
+    if (first_) return writeFirst(value);
+    return compressValue(value);
+  }
+
+ private:
+  static constexpr int kBits = Traits::kBits;
+  static constexpr int kShortCenterLimit = 1 << Traits::kShortCenterBits;
+
+  Sink &sink_;
+  int storedLeadingZeros_ = __INT32_MAX__;
+  int storedTrailingZeros_ = __INT32_MAX__;
+  Bits storedVal_ = 0;
+  bool first_ = true;
+
+  int writeFirst(Bits value) {
+    first_ = false;
+    storedVal_ = value;
+    int trailingZeros = value == 0 ? kBits : Traits::Ctz(value);
+    sink_.Write(trailingZeros, Traits::kFirstTrailingBits);
+    if (value == 0) return Traits::kFirstTrailingBits;
+    sink_.Write(storedVal_ >> (trailingZeros + 1), kBits - 1 - trailingZeros);
+    return Traits::kFirstTrailingBits + kBits - 1 - trailingZeros;
+  }
+
+  int compressValue(Bits value) {
+    Bits xorValue = storedVal_ ^ value;
+    if (xorValue == 0) {
+      sink_.Write(1, 2);
+      return 2;
+    }
+    int leadingZeros = Traits::kLeadingRound[Traits::Clz(xorValue)];
+    int trailingZeros = Traits::Ctz(xorValue);
+    storedVal_ = value;
+
+    if (leadingZeros == storedLeadingZeros_ && trailingZeros >= storedTrailingZeros_) {
+      // '00' followed by the center bits
+      int centerBits = kBits - storedLeadingZeros_ - storedTrailingZeros_;
+      int len = 2 + centerBits;
+      if (len > 64) {
+        sink_.Write(0, 2);
+        sink_.Write(xorValue >> storedTrailingZeros_, centerBits);
+      } else {
+        sink_.Write(xorValue >> storedTrailingZeros_, len);
+      }
+      return len;
+    }
+
+    storedLeadingZeros_ = leadingZeros;
+    storedTrailingZeros_ = trailingZeros;
+    int centerBits = kBits - leadingZeros - trailingZeros;
+    // The center always ends with a one, so only centerBits - 1 bits are stored
+    if (centerBits <= kShortCenterLimit) {
+      sink_.Write((((0x2 << 3) | Traits::kLeadingRepresentation[leadingZeros]) << Traits::kShortCenterBits)
+                  | (centerBits & (kShortCenterLimit - 1)), 5 + Traits::kShortCenterBits);
+      sink_.Write(xorValue >> (trailingZeros + 1), centerBits - 1);
+      return 4 + Traits::kShortCenterBits + centerBits;
+    }
+    sink_.Write((((0x3 << 3) | Traits::kLeadingRepresentation[leadingZeros]) << Traits::kLongCenterBits)
+                | (centerBits & ((1 << Traits::kLongCenterBits) - 1)), 5 + Traits::kLongCenterBits);
+    sink_.Write(xorValue >> (trailingZeros + 1), centerBits - 1);
+    return 4 + Traits::kLongCenterBits + centerBits;
+  }
+};
+
+template<typename T, typename Sink = bitstream::BitWriter, typename XORStage = ElfXORCompressor<T, Sink>>
+class ElfCompressor {
+ public:
+  using Traits = ElfTraits<T>;
+  using Bits = typename Traits::Bits;
+
+  explicit ElfCompressor(Sink &sink) : sink_(sink), xorCompressor_(sink) {}
+
+  void addValue(T v) {
+    Bits bits;
+    std::memcpy(&bits, &v, sizeof(T));
+    Bits vPrime = bits;
+    assert(!std::isnan(v));
+    if (v == 0) {
+      size_ += sink_.Write(2, 2);
+    } else {
+      int *alphaAndBetaStar = getAlphaAndBetaStar(v, lastBetaStar_);
+      int e = static_cast<int>(bits >> Traits::kMantissaBits) & Traits::kExponentMask;
+      int gAlpha = getFAlpha(alphaAndBetaStar[0]) + e - Traits::kExponentBias;
+      int eraseBits = Traits::kMantissaBits - gAlpha;
+      Bits mask = ~static_cast<Bits>(0) << eraseBits;
+      Bits delta = ~mask & bits;
+      if (delta != 0 && eraseBits >= Traits::kMinEraseBits) {
+        if (alphaAndBetaStar[1] == lastBetaStar_) {
+          size_ += sink_.Write(0, 1);
+        } else {
+          size_ += sink_.Write(alphaAndBetaStar[1] | (0x3 << Traits::kBetaStarBits), 2 + Traits::kBetaStarBits);
+          lastBetaStar_ = alphaAndBetaStar[1];
+        }
+        vPrime = mask & bits;
+      } else {
+        size_ += sink_.Write(2, 2);
+      }
+      delete[] alphaAndBetaStar;
+    }
+    size_ += xorCompressor_.addValue(vPrime);
+  }
+
+  // Writes the end marker, which is not counted in getSize()
+  void close() {
+    sink_.Write(2, 2);
+  }
+
+  // In bits, including the 32-bit value count
+  size_t getSize() const {
+    return size_;
+  }
+
+ private:
+  Sink &sink_;
+  XORStage xorCompressor_;
+  size_t size_ = 32;
+  int lastBetaStar_ = __INT32_MAX__;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "ElfTraits.h"
+#include "bit_reader.h"
+
+// Elf decoder pipeline mirroring ElfCompressor: the bit source feeds
+// ElfXORDecompressor, whose values ElfDecompressor restores from their erased
+// form. All stages are template parameters, so nothing is virtual.
+
+template<typename T, typename Source = bitstream::BitReader>
+class ElfXORDecompressor {
+ public:
+  using Traits = ElfTraits<T>;
+  using Bits = typename Traits::Bits;
+
+  explicit ElfXORDecompressor(Source &source) : source_(source) {}
+
+  T readValue() {
+    if (first_) {
+      readFirst();
+    } else {
+      readNext();
+    }
+    T v;
+    std::memcpy(&v, &storedVal_, sizeof(T));
+    return v;
+  }
+
+ private:
+  static constexpr int kBits = Traits::kBits;
+
+  Source &source_;
+  Bits storedVal_ = 0;
+  int storedLeadingZeros_ = __INT32_MAX__;
+  int storedTrailingZeros_ = __INT32_MAX__;
+  bool first_ = true;
+
+  void readFirst() {
+    first_ = false;
+    int trailingZeros = static_cast<int>(source_.Read(Traits::kFirstTrailingBits));
+    if (trailingZeros < kBits) {
+      storedVal_ = ((static_cast<Bits>(source_.Read(kBits - 1 - trailingZeros)) << 1) + 1) << trailingZeros;
+    } else {
+      storedVal_ = 0;
+    }
+  }
+
+  void readNext() {
+    int centerBits;
+    uint32_t leadAndCenter;
+    switch (source_.Read(2)) {
+      case 3:
+        leadAndCenter = source_.Read(3 + Traits::kLongCenterBits);
+        storedLeadingZeros_ = Traits::kLeadingDecode[leadAndCenter >> Traits::kLongCenterBits];
+        centerBits = leadAndCenter & ((1 << Traits::kLongCenterBits) - 1);
+        if (centerBits == 0) centerBits = kBits;
+        storedTrailingZeros_ = kBits - storedLeadingZeros_ - centerBits;
+        storedVal_ ^= ((static_cast<Bits>(source_.Read(centerBits - 1)) << 1) + 1) << storedTrailingZeros_;
+        break;
+      case 2:
+        leadAndCenter = source_.Read(3 + Traits::kShortCenterBits);
+        storedLeadingZeros_ = Traits::kLeadingDecode[leadAndCenter >> Traits::kShortCenterBits];
+        centerBits = leadAndCenter & ((1 << Traits::kShortCenterBits) - 1);
+        if (centerBits == 0) centerBits = 1 << Traits::kShortCenterBits;
+        storedTrailingZeros_ = kBits - storedLeadingZeros_ - centerBits;
+        storedVal_ ^= ((static_cast<Bits>(source_.Read(centerBits - 1)) << 1) + 1) << storedTrailingZeros_;
+        break;
+      case 1:
+        break;
+      default:
+        centerBits = kBits - storedLeadingZeros_ - storedTrailingZeros_;
+        storedVal_ ^= static_cast<Bits>(source_.Read(centerBits)) << storedTrailingZeros_;
+        break;
+    }
+  }
+};
+
+template<typename T, typename Source = bitstream::BitReader,
+    typename XORStage = ElfXORDecompressor<T, Source>>
+class ElfDecompressor {
+ public:
+  using Traits = ElfTraits<T>;
+
+  explicit ElfDecompressor(Source &source) : source_(source), xorDecompressor_(source) {}
+
+  int decompress(T *output, int length) {
+    for (int i = 0; i < length; i++) output[i] = nextValue();
+    return length;
+  }
+
+ private:
+  Source &source_;
+  XORStage xorDecompressor_;
+  int lastBetaStar_ = __INT32_MAX__;
+
+  T nextValue() {
+    if (source_.Read(1) == 0) return recoverVByBetaStar();
+    if (source_.Read(1) == 0) return xorDecompressor_.readValue();
+    lastBetaStar_ = static_cast<int>(source_.Read(Traits::kBetaStarBits));
+    return recoverVByBetaStar();
+  }
+
+  T recoverVByBetaStar() {
+    T vPrime = xorDecompressor_.readValue();
+    int sp = getSP(std::abs(vPrime));
+    if (lastBetaStar_ == 0) {
+      T v = get10iN<T>(-sp - 1);
+      return vPrime < 0 ? -v : v;
+    }
+    return roundUp(vPrime, lastBetaStar_ - sp - 1);
+  }
+};
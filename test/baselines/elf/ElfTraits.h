@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+
+#include "defs.h"
+
+// Everything the Elf pipeline needs to know about a floating-point type: the
+// IEEE 754 layout, the widths of the Elf and XOR control fields, and the
+// leading zero tables.
+template<typename T>
+struct ElfTraits;
+
+template<>
+struct ElfTraits<double> {
+  using Bits = uint64_t;
+  static constexpr int kBits = 64;
+  static constexpr int kMantissaBits = 52;
+  static constexpr int kExponentMask = 0x7ff;
+  static constexpr int kExponentBias = 1023;
+  // Erasing fewer bits than this does not pay for the beta* header
+  static constexpr int kMinEraseBits = 5;
+  static constexpr int kBetaStarBits = 4;
+  static constexpr int kFirstTrailingBits = 7;
+  // Center bits field of the '10' (short) and '11' (long) XOR cases
+  static constexpr int kShortCenterBits = 4;
+  static constexpr int kLongCenterBits = 6;
+
+  static constexpr short kLeadingRepresentation[64] =
+      {0, 0, 0, 0, 0, 0, 0, 0,
+       1, 1, 1, 1, 2, 2, 2, 2,
+       3, 3, 4, 4, 5, 5, 6, 6,
+       7, 7, 7, 7, 7, 7, 7, 7,
+       7, 7, 7, 7, 7, 7, 7, 7,
+       7, 7, 7, 7, 7, 7, 7, 7,
+       7, 7, 7, 7, 7, 7, 7, 7,
+       7, 7, 7, 7, 7, 7, 7, 7};
+  static constexpr short kLeadingRound[64] =
+      {0, 0, 0, 0, 0, 0, 0, 0,
+       8, 8, 8, 8, 12, 12, 12, 12,
+       16, 16, 18, 18, 20, 20, 22, 22,
+       24, 24, 24, 24, 24, 24, 24, 24,
+       24, 24, 24, 24, 24, 24, 24, 24,
+       24, 24, 24, 24, 24, 24, 24, 24,
+       24, 24, 24, 24, 24, 24, 24, 24,
+       24, 24, 24, 24, 24, 24, 24, 24};
+  static constexpr short kLeadingDecode[8] = {0, 8, 12, 16, 18, 20, 22, 24};
+
+  static int Clz(Bits x) { return __builtin_clzll(x); }
+  static int Ctz(Bits x) { return __builtin_ctzll(x); }
+};
+
+template<>
+struct ElfTraits<float> {
+  using Bits = uint32_t;
+  static constexpr int kBits = 32;
+  static constexpr int kMantissaBits = 23;
+  static constexpr int kExponentMask = 0xff;
+  static constexpr int kExponentBias = 127;
+  static constexpr int kMinEraseBits = 4;
+  static constexpr int kBetaStarBits = 3;
+  static constexpr int kFirstTrailingBits = 6;
+  static constexpr int kShortCenterBits = 3;
+  static constexpr int kLongCenterBits = 5;
+
+  static constexpr short kLeadingRepresentation[32] =
+      {0, 0, 0, 0, 0, 0, 1, 1,
+       1, 1, 2, 2, 3, 3, 4, 4,
+       5, 5, 6, 6, 7, 7, 7, 7,
+       7, 7, 7, 7, 7, 7, 7, 7};
+  static constexpr short kLeadingRound[32] =
+      {0, 0, 0, 0, 0, 0, 6, 6,
+       6, 6, 10, 10, 12, 12, 14, 14,
+       16, 16, 18, 18, 20, 20, 20, 20,
+       20, 20, 20, 20, 20, 20, 20, 20};
+  static constexpr short kLeadingDecode[8] = {0, 6, 10, 12, 14, 16, 18, 20};
+
+  static int Clz(Bits x) { return __builtin_clz(x); }
+  static int Ctz(Bits x) { return __builtin_ctz(x); }
+};
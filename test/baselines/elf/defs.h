@@ -12,12 +12,12 @@ union FLOAT {
   uint32_t i;
 };
 
-// Utils
+// Utils; T is double or float, both instantiated in utils.cc
 int getFAlpha(int alpha);
-int *getAlphaAndBetaStar(double v, int lastBetaStar);
-int *getAlphaAndBetaStar_32(float v, int lastBetaStar);
-double roundUp(double v, int alpha);
-float roundUp_32(float v, int alpha);
-double get10iN(int i);
-float get10iN_32(int i);
+template<typename T>
+int *getAlphaAndBetaStar(T v, int lastBetaStar);
+template<typename T>
+T roundUp(T v, int alpha);
+template<typename T>
+T get10iN(int i);
 int getSP(double v);
\ No newline at end of file
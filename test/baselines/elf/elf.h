@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <sys/types.h>
 
 #ifdef __cplusplus
 extern "C" {
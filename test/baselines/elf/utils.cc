@@ -3,7 +3,7 @@
 
 #include "defs.h"
 
-#define LENGTH_OF(x) (sizeof(x)/sizeof((x)[0]))
+#define LENGTH_OF(x) static_cast<int>(sizeof(x)/sizeof((x)[0]))
 
 static const int f[] = {0, 4, 7, 10, 14, 17, 20, 24, 27, 30, 34, 37, 40, 44, 47, 50, 54, 57, 60, 64, 67};
 
@@ -32,161 +32,159 @@ static const float mapSPLess1_32[] = {1, 0.1f, 0.01f, 0.001f, 0.0001f, 0.00001f,
 
 static const double LOG_2_10 = 3.321928095;
 
-static int getSignificantCount(double v, int sp, int lastBetaStar);
-static int getSignificantCount_32(float v, int sp, int lastBetaStar);
-static double get10iP(int i);
-static float get10iP_32(int i);
-static int *getSPAnd10iNFlag(double v);
-
-int getFAlpha(int alpha) {
-  assert(alpha >= 0);
-  if (alpha >= LENGTH_OF(f)) {
-    return (int) ceilf64(alpha * LOG_2_10);
-  } else {
-    return f[alpha];
-  }
-}
-
-int *getAlphaAndBetaStar(double v, int lastBetaStar) {
-  v = v < 0 ? -v : v;
-  int *alphaAndBetaStar = new int[2];
-  int *spAnd10iNFlag = getSPAnd10iNFlag(v);
-  int beta = getSignificantCount(v, spAnd10iNFlag[0], lastBetaStar);
-  alphaAndBetaStar[0] = beta - spAnd10iNFlag[0] - 1;
-  alphaAndBetaStar[1] = spAnd10iNFlag[1] == 1 ? 0 : beta;
-  delete[] spAnd10iNFlag;
-  return alphaAndBetaStar;
-}
-
-int *getAlphaAndBetaStar_32(float v, int lastBetaStar) {
-  v = v < 0 ? -v : v;
-  int *alphaAndBetaStar = new int[2];
-  int *spAnd10iNFlag = getSPAnd10iNFlag(v);
-  int beta = getSignificantCount_32(v, spAnd10iNFlag[0], lastBetaStar);
-  alphaAndBetaStar[0] = beta - spAnd10iNFlag[0] - 1;
-  alphaAndBetaStar[1] = spAnd10iNFlag[1] == 1 ? 0 : beta;
-  delete[] spAnd10iNFlag;
-  return alphaAndBetaStar;
-}
-
-double roundUp(double v, int alpha) {
-  double scale = get10iP(alpha);
-  if (v < 0) {
-    return floorf64(v * scale) / scale;
-  } else {
-    return ceil(v * scale) / scale;
-  }
-}
-
-float roundUp_32(float v, int alpha) {
-  float scale = get10iP_32(alpha);
-  if (v < 0) {
-    return floorf(v * scale) / scale;
+// What the helpers below take from the value type. The float helpers stay in
+// float throughout: 0.1f is not the double 0.1.
+template<typename T>
+struct DecimalTables;
+
+template<>
+struct DecimalTables<double> {
+  using Integer = long;
+  // Significant digits that always tell two doubles apart
+  static constexpr int kMaxSignificantCount = 17;
+  static constexpr const double *k10iP = map10iP;
+  static constexpr const double *k10iN = map10iN;
+  static constexpr const double *kSPLess1 = mapSPLess1;
+  static double Pow10(int i) { return powf64(10, i); }
+};
+
+template<>
+struct DecimalTables<float> {
+  using Integer = int;
+  static constexpr int kMaxSignificantCount = 8;
+  static constexpr const float *k10iP = map10iP_32;
+  static constexpr const float *k10iN = map10iN_32;
+  static constexpr const float *kSPLess1 = mapSPLess1_32;
+  static float Pow10(int i) { return powf32(10, i); }
+};
+
+static_assert(LENGTH_OF(map10iP) == LENGTH_OF(map10iP_32) && LENGTH_OF(map10iN) == LENGTH_OF(map10iN_32) &&
+              LENGTH_OF(map10iP) == LENGTH_OF(map10iN) && LENGTH_OF(mapSPLess1) == LENGTH_OF(mapSPLess1_32),
+              "the double and float tables cover the same powers");
+
+template<typename T>
+static T get10iP(int i) {
+  assert(i >= 0);
+  if (i >= LENGTH_OF(map10iP)) {
+    return DecimalTables<T>::Pow10(i);
   } else {
-    return ceilf(v * scale) / scale;
+    return DecimalTables<T>::k10iP[i];
   }
 }
 
-static int getSignificantCount(double v, int sp, int lastBetaStar) {
+template<typename T>
+static int getSignificantCount(T v, int sp, int lastBetaStar) {
+  using Integer = typename DecimalTables<T>::Integer;
   int i;
   if (lastBetaStar != __INT32_MAX__ && lastBetaStar != 0) {
     i = lastBetaStar - sp - 1;
     i = i > 1 ? i : 1;
   } else if (lastBetaStar == __INT32_MAX__) {
-    i = 17 - sp - 1;
+    i = DecimalTables<T>::kMaxSignificantCount - sp - 1;
   } else if (sp >= 0) {
     i = 1;
   } else {
     i = -sp;
   }
 
-  double temp = v * get10iP(i);
-  long tempLong = (long) temp;
-  while (tempLong != temp) {
+  T temp = v * get10iP<T>(i);
+  Integer tempInteger = (Integer) temp;
+  while (tempInteger != temp) {
     i++;
-    temp = v * get10iP(i);
-    tempLong = (long) temp;
+    temp = v * get10iP<T>(i);
+    tempInteger = (Integer) temp;
   }
 
-  if (temp / get10iP(i) != v) {
-    return 17;
+  if (temp / get10iP<T>(i) != v) {
+    return DecimalTables<T>::kMaxSignificantCount;
   } else {
-    while (i > 0 && tempLong % 10 == 0) {
+    while (i > 0 && tempInteger % 10 == 0) {
       i--;
-      tempLong = tempLong / 10;
+      tempInteger = tempInteger / 10;
     }
     return sp + i + 1;
   }
 }
 
-static int getSignificantCount_32(float v, int sp, int lastBetaStar) {
-  int i;
-  if (lastBetaStar != __INT32_MAX__ && lastBetaStar != 0) {
-    i = lastBetaStar - sp - 1;
-    i = i > 1 ? i : 1;
-  } else if (lastBetaStar == __INT32_MAX__) {
-    i = 8 - sp - 1;
-  } else if (sp >= 0) {
-    i = 1;
-  } else {
-    i = -sp;
-  }
-
-  float temp = v * get10iP_32(i);
-  int tempInt = (int) temp;
-  while (tempInt != temp) {
-    i++;
-    temp = v * get10iP_32(i);
-    tempInt = (int) temp;
-  }
-
-  if (temp / get10iP_32(i) != v) {
-    return 8;
+template<typename T>
+static int *getSPAnd10iNFlag(T v) {
+  const T *spLess1 = DecimalTables<T>::kSPLess1;
+  int *spAnd10iNFlag = new int[2];
+  spAnd10iNFlag[1] = 0;
+  if (v >= 1) {
+    int i = 0;
+    while (i < LENGTH_OF(mapSPGreater1) - 1) {
+      if (v < mapSPGreater1[i + 1]) {
+        spAnd10iNFlag[0] = i;
+        return spAnd10iNFlag;
+      }
+      i++;
+    }
   } else {
-    while (i > 0 && tempInt % 10 == 0) {
-      i--;
-      tempInt = tempInt / 10;
+    int i = 1;
+    while (i < LENGTH_OF(mapSPLess1)) {
+      if (v >= spLess1[i]) {
+        spAnd10iNFlag[0] = -i;
+        spAnd10iNFlag[1] = v == spLess1[i] ? 1 : 0;
+        return spAnd10iNFlag;
+      }
+      i++;
     }
-    return sp + i + 1;
   }
+  T log10v = std::log10(v);
+  spAnd10iNFlag[0] = (int) std::floor(log10v);
+  spAnd10iNFlag[1] = log10v == (long) log10v ? 1 : 0;
+  return spAnd10iNFlag;
 }
 
-static double get10iP(int i) {
-  assert(i >= 0);
-  if (i >= LENGTH_OF(map10iP)) {
-    return powf64(10, i);
+int getFAlpha(int alpha) {
+  assert(alpha >= 0);
+  if (alpha >= LENGTH_OF(f)) {
+    return (int) ceilf64(alpha * LOG_2_10);
   } else {
-    return map10iP[i];
+    return f[alpha];
   }
 }
 
-static float get10iP_32(int i) {
-  assert(i >= 0);
-  if (i >= LENGTH_OF(map10iP)) {
-    return powf32(10, i);
-  } else {
-    return map10iP_32[i];
-  }
+template<typename T>
+int *getAlphaAndBetaStar(T v, int lastBetaStar) {
+  v = v < 0 ? -v : v;
+  int *alphaAndBetaStar = new int[2];
+  int *spAnd10iNFlag = getSPAnd10iNFlag(v);
+  int beta = getSignificantCount(v, spAnd10iNFlag[0], lastBetaStar);
+  alphaAndBetaStar[0] = beta - spAnd10iNFlag[0] - 1;
+  alphaAndBetaStar[1] = spAnd10iNFlag[1] == 1 ? 0 : beta;
+  delete[] spAnd10iNFlag;
+  return alphaAndBetaStar;
 }
 
-double get10iN(int i) {
-  assert(i >= 0);
-  if (i >= LENGTH_OF(map10iN)) {
-    return powf64(10, -i);
+template<typename T>
+T roundUp(T v, int alpha) {
+  T scale = get10iP<T>(alpha);
+  if (v < 0) {
+    return std::floor(v * scale) / scale;
   } else {
-    return map10iN[i];
+    return std::ceil(v * scale) / scale;
   }
 }
 
-float get10iN_32(int i) {
+template<typename T>
+T get10iN(int i) {
   assert(i >= 0);
   if (i >= LENGTH_OF(map10iN)) {
-    return powf32(10, -i);
+    return DecimalTables<T>::Pow10(-i);
   } else {
-    return map10iN_32[i];
+    return DecimalTables<T>::k10iN[i];
   }
 }
 
+template int *getAlphaAndBetaStar<double>(double v, int lastBetaStar);
+template int *getAlphaAndBetaStar<float>(float v, int lastBetaStar);
+template double roundUp<double>(double v, int alpha);
+template float roundUp<float>(float v, int alpha);
+template double get10iN<double>(int i);
+template float get10iN<float>(int i);
+
 int getSP(double v) {
   if (v >= 1) {
     int i = 0;
@@ -207,31 +205,3 @@ int getSP(double v) {
   }
   return (int) floor(log10(v));
 }
-
-static int *getSPAnd10iNFlag(double v) {
-  int *spAnd10iNFlag = new int[2];
-  if (v >= 1) {
-    int i = 0;
-    while (i < LENGTH_OF(mapSPGreater1) - 1) {
-      if (v < mapSPGreater1[i + 1]) {
-        spAnd10iNFlag[0] = i;
-        return spAnd10iNFlag;
-      }
-      i++;
-    }
-  } else {
-    int i = 1;
-    while (i < LENGTH_OF(mapSPLess1)) {
-      if (v >= mapSPLess1[i]) {
-        spAnd10iNFlag[0] = -i;
-        spAnd10iNFlag[1] = v == mapSPLess1[i] ? 1 : 0;
-        return spAnd10iNFlag;
-      }
-      i++;
-    }
-  }
-  double log10v = log10(v);
-  spAnd10iNFlag[0] = (int) floor(log10v);
-  spAnd10iNFlag[1] = log10v == (long) log10v ? 1 : 0;
-  return spAnd10iNFlag;
-}
\ No newline at end of file
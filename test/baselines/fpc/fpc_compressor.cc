@@ -1,97 +1,87 @@
 #include "fpc_compressor.h"
 
-const long long FpcCompressor::mask[8] = {
-        0x0000000000000000LL,
-        0x00000000000000ffLL,
-        0x000000000000ffffLL,
-        0x0000000000ffffffLL,
-        0x000000ffffffffffLL,
-        0x0000ffffffffffffLL,
-        0x00ffffffffffffffLL,
-        static_cast<long long>(0xffffffffffffffff)
-};
-
-long FpcCompressor::getCompressedSizeInBits() {
+template<typename T>
+long BasicFpcCompressor<T>::getCompressedSizeInBits() {
     return compressedSizeInBits;
 }
 
-FpcCompressor::FpcCompressor(long pred, int num) {
-    intot = num;
-    predsizem1 = pred;
+// A value takes at most a 4-bit code and sizeof(T) residual bytes
+template<typename T>
+uint32_t BasicFpcCompressor<T>::bufferSize(long num) {
+    return static_cast<uint32_t>(num * (2 * sizeof(T) + 1) / 2 + 8);
+}
 
-    outbuf[0] = predsizem1;
-    predsizem1 = (1L << predsizem1) - 1;
+template<typename T>
+BasicFpcCompressor<T>::BasicFpcCompressor(long pred, int num) : outStream(bufferSize(num)) {
+    predsizem1 = (1L << pred) - 1;
+    fcm.resize(predsizem1 + 1);
+    dfcm.resize(predsizem1 + 1);
+    capacity = num;
+    reset(num);
+}
+
+template<typename T>
+void BasicFpcCompressor<T>::reset(int num) {
+    intot = num;
+    count = 0;
+    if (num > capacity) {
+        outStream.Reserve(bufferSize(num));
+        capacity = num;
+    }
+    outStream.Refresh();
+    compressedSizeInBits = 0;
 
     hash = 0;
     dhash = 0;
     lastval = 0;
     pred1 = 0;
     pred2 = 0;
-    fcm = (long long *)calloc(predsizem1 + 1, 8);
-    dfcm = (long long *)calloc(predsizem1 + 1, 8);
-
-    out = ((intot + 1));
-    *((long long *)&outbuf[(out >> 3) << 3]) = 0;
-}
-
-FpcCompressor::~FpcCompressor() {
-    free(fcm);
-    free(dfcm);
+    memset(fcm.data(), 0, fcm.size() * sizeof(Bits));
+    memset(dfcm.data(), 0, dfcm.size() * sizeof(Bits));
 }
 
-void FpcCompressor::addValue(double v) {
-    memcpy(&val, &v, sizeof(double));
+template<typename T>
+void BasicFpcCompressor<T>::addValue(T v) {
+    val = Traits::ToBits(v);
     xor1 = val ^ pred1;
     fcm[hash] = val;
-    hash = ((hash << 6) ^ ((unsigned long long)val >> 48)) & predsizem1;
+    hash = ((hash << 6) ^ (val >> (Traits::kBits - 16))) & predsizem1;
     pred1 = fcm[hash];
 
     stride = val - lastval;
     xor2 = val ^ (lastval + pred2);
     lastval = val;
     dfcm[dhash] = stride;
-    dhash = ((dhash << 2) ^ ((unsigned long long)stride >> 40)) & predsizem1;
+    dhash = ((dhash << 2) ^ (stride >> (Traits::kBits - 24))) & predsizem1;
     pred2 = dfcm[dhash];
 
     code = 0;
-    if ((unsigned long long)xor1 > (unsigned long long)xor2) {
+    if (xor1 > xor2) {
         code = 0x8;
         xor1 = xor2;
     }
-    bcode = 7; // 8 bytes: bcode指异或值的字节数量
-    if (0 == (xor1 >> 56))
-        bcode = 6; // 7 bytes
-    if (0 == (xor1 >> 48))
-        bcode = 5; // 6 bytes
-    if (0 == (xor1 >> 40))
-        bcode = 4; // 5 bytes
-    if (0 == (xor1 >> 24))
-        bcode = 3; // 3 bytes
-    if (0 == (xor1 >> 16))
-        bcode = 2; // 2 bytes
-    if (0 == (xor1 >> 8))
-        bcode = 1; // 1 byte
-    if (0 == xor1)
-        bcode = 0; // 0 bytes
+    // Residual bytes, and the code that stands for them
+    int bytes = xor1 == 0 ? 0 : (Traits::kBits - Traits::Clz(xor1) + 7) / 8;
+    if (Traits::kBits == 64 && bytes == 4) bytes = 5;
+    bcode = bytes > 4 ? bytes - 1 : bytes;
 
-    out += bcode + (bcode >> 2); // 0 ~ 8 需要写入的数据大小
     code |= bcode;
-    i++;
+    if (++count > capacity) {
+        capacity = 2 * count;
+        outStream.Reserve(bufferSize(capacity));
+    }
 
-    // 第一个outbuf写入数据时，前面的所有数据都已经稳定，可以write进数据流中
     outStream.WriteInt(code, 4);
     compressedSizeInBits += 4;
 
-    if (bcode >= 4) {
-        outStream.WriteLong(xor1, (bcode + 1) * 8);
-        compressedSizeInBits += (bcode + 1) * 8;
-    } else if (bcode > 0) {
-        outStream.WriteLong(xor1, bcode * 8);
-        compressedSizeInBits += bcode * 8;
+    if (bytes > 0) {
+        outStream.WriteLong(xor1, bytes * 8);
+        compressedSizeInBits += bytes * 8;
     }
 }
 
-std::vector<char> FpcCompressor::getBytes() {
+template<typename T>
+std::vector<char> BasicFpcCompressor<T>::getBytes() {
     int byteCount = std::ceil(compressedSizeInBits / 8.0);
     std::vector<char> result;
     result.reserve(byteCount);
@@ -102,10 +92,10 @@ std::vector<char> FpcCompressor::getBytes() {
     return result;
 }
 
-void FpcCompressor::close() {
-    if (0 != (intot & 1)) {
-        out -= bcode + (bcode >> 2);
-    }
-    i = 0;
+template<typename T>
+void BasicFpcCompressor<T>::close() {
     outStream.Flush();
-}
\ No newline at end of file
+}
+
+template class BasicFpcCompressor<double>;
+template class BasicFpcCompressor<float>;
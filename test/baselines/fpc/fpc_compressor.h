@@ -1,29 +1,51 @@
+#ifndef FPC_COMPRESSOR_H
+#define FPC_COMPRESSOR_H
+
 #include <cstring>
 #include <cmath>
 #include <vector>
 
 #include "output_bit_stream.h"
+#include "float_traits.h"
 
-#define SIZE 32768
-
-class FpcCompressor {
+// FPC over the bits of a T, instantiated for double and float in
+// fpc_compressor.cc. The FCM and DFCM hashes take the top 16 and 24 bits of
+// the value and the stride. A residual is 0 to sizeof(T) bytes in a 4-bit
+// code; the double code has no 4-byte case and writes those residuals in 5.
+//
+// Buffers are sized from the expected value count and grow past it, and the
+// predictor tables are allocated once: reset() clears them so one instance can
+// encode any number of blocks.
+template<typename T>
+class BasicFpcCompressor {
 private:
-    OutputBitStream outStream = OutputBitStream(6 + (SIZE / 2) + (SIZE * 8) + 2);
-    static const long long mask[8];
-    long i, out, intot, hash, dhash, code, bcode, ioc;
-    long long val, lastval, stride, pred1, pred2, xor1, xor2;
-    long long *fcm, *dfcm;
-    unsigned long long inbuf[SIZE + 1];
-    unsigned char outbuf[6 + (SIZE / 2) + (SIZE * 8) + 2];
+    using Traits = bitstream::FloatTraits<T>;
+    using Bits = typename Traits::Bits;
+
+    OutputBitStream outStream;
+    long intot, count, capacity, hash, dhash, code, bcode;
+    Bits val, lastval, stride, pred1, pred2, xor1, xor2;
+    std::vector<Bits> fcm, dfcm;
     long predsizem1;
 
+    static uint32_t bufferSize(long num);
+
 public:
-    FpcCompressor(long pred, int intot);
-    ~FpcCompressor();
-    void addValue(double v);
+    BasicFpcCompressor(long pred, int intot);
+    void addValue(T v);
     void close();
+    // Starts a new block of num values, reusing the tables and buffers
+    void reset(int num);
     long getCompressedSizeInBits();
     std::vector<char> getBytes();
 
-    int compressedSizeInBits = 0;
-};
\ No newline at end of file
+    long compressedSizeInBits = 0;
+};
+
+extern template class BasicFpcCompressor<double>;
+extern template class BasicFpcCompressor<float>;
+
+using FpcCompressor = BasicFpcCompressor<double>;
+using FpcCompressor32 = BasicFpcCompressor<float>;
+
+#endif // FPC_COMPRESSOR_H
@@ -1,36 +1,46 @@
+#ifndef FPC_DECOMPRESSOR_H
+#define FPC_DECOMPRESSOR_H
+
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
 #include <cassert>
 #include <vector>
 #include <algorithm>
 
 #include "input_bit_stream.h"
+#include "float_traits.h"
 
-#define SIZE 32768
-
-class FpcDecompressor {
+// Decoder for BasicFpcCompressor<T>, instantiated for double and float in
+// fpc_decompressor.cc
+template<typename T>
+class BasicFpcDecompressor {
 private:
-    InputBitStream inStream = InputBitStream(nullptr, 0);
+    using Traits = bitstream::FloatTraits<T>;
+    using Bits = typename Traits::Bits;
+
+    InputBitStream inStream;
 
 public:
-    static const long long mask[8];
-    long i, in, intot, hash, dhash, code, bcode, predsizem1, end, tmp, ioc;
-    long long val, lastval, stride, pred1, pred2, next;
-    long long *fcm, *dfcm;
-    long long outbuf[SIZE];
-    unsigned char inbuf[(SIZE / 2) + (SIZE * 8) + 6 + 2];
+    long i, intot, hash, dhash, code, bcode, predsizem1;
+    Bits val, lastval, stride, pred1, pred2;
+    std::vector<Bits> fcm, dfcm;
 
-    FpcDecompressor(long pred, int num);
-    ~FpcDecompressor();
+    BasicFpcDecompressor(long pred, int num);
 
     void setBytes(char *data, size_t data_size);
 
-    void close();
+    // Starts a new block of num values, reusing the tables
+    void reset(int num);
+    std::vector<T> decompress();
+    // Writes the intot values of the block to output
+    int decompress(T *output);
+};
+
+extern template class BasicFpcDecompressor<double>;
+extern template class BasicFpcDecompressor<float>;
 
-    void refresh();
-    std::vector<double> decompress();
-    std::vector<double> result;
+using FpcDecompressor = BasicFpcDecompressor<double>;
+using FpcDecompressor32 = BasicFpcDecompressor<float>;
 
-    long _tmp_;
-    long _out_;
-};
\ No newline at end of file
+#endif // FPC_DECOMPRESSOR_H
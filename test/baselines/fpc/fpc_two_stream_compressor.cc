@@ -0,0 +1,72 @@
+#include "fpc_two_stream_compressor.h"
+
+#include <cstring>
+
+// FPC cannot encode a 4-byte residual, it is widened to 5 bytes
+const uint8_t FpcTwoStreamCompressor::kCodeToByteCount[8] = {0, 1, 2, 3, 5, 6, 7, 8};
+const uint8_t FpcTwoStreamCompressor::kByteCountToCode[9] = {0, 1, 2, 3, 4, 4, 5, 6, 7};
+
+FpcTwoStreamCompressor::FpcTwoStreamCompressor(long pred) {
+    pred_bits_ = pred;
+    hash_mask_ = (1UL << pred) - 1;
+    fcm_.resize(hash_mask_ + 1);
+    dfcm_.resize(hash_mask_ + 1);
+    residuals_.resize(8);
+}
+
+void FpcTwoStreamCompressor::addValue(double v) {
+    uint64_t val;
+    memcpy(&val, &v, sizeof(double));
+    uint64_t xor1 = val ^ pred1_;
+    fcm_[hash_] = val;
+    hash_ = ((hash_ << 6) ^ (val >> 48)) & hash_mask_;
+    pred1_ = fcm_[hash_];
+
+    uint64_t stride = val - lastval_;
+    uint64_t xor2 = val ^ (lastval_ + pred2_);
+    lastval_ = val;
+    dfcm_[dhash_] = stride;
+    dhash_ = ((dhash_ << 2) ^ (stride >> 40)) & hash_mask_;
+    pred2_ = dfcm_[dhash_];
+
+    uint8_t code = 0;
+    if (xor1 > xor2) {
+        code = 0x8;
+        xor1 = xor2;
+    }
+    // Significant bytes from the leading zero count (lzcnt where available)
+    int bytes = xor1 == 0 ? 0 : 8 - (__builtin_clzll(xor1) >> 3);
+    uint8_t bcode = kByteCountToCode[bytes];
+    code |= bcode;
+
+    if ((count_ & 1) == 0) {
+        codes_.push_back(code);
+    } else {
+        codes_.back() |= code << 4;
+    }
+    ++count_;
+
+    // Store the whole word, then advance past its significant bytes only
+    memcpy(residuals_.data() + residual_size_, &xor1, sizeof(uint64_t));
+    residual_size_ += kCodeToByteCount[bcode];
+    if (residuals_.size() < residual_size_ + 8) residuals_.resize(residuals_.size() * 2);
+}
+
+void FpcTwoStreamCompressor::compress(const double *values, int count) {
+    codes_.reserve(codes_.size() + count / 2 + 1);
+    for (int i = 0; i < count; ++i) addValue(values[i]);
+}
+
+long FpcTwoStreamCompressor::getCompressedSizeInBits() {
+    return (kHeaderSize + static_cast<long>(codes_.size() + residual_size_)) * 8;
+}
+
+std::vector<uint8_t> FpcTwoStreamCompressor::getBytes() {
+    std::vector<uint8_t> result(kHeaderSize + codes_.size() + residual_size_);
+    result[0] = static_cast<uint8_t>(pred_bits_);
+    uint32_t count = count_;
+    for (int k = 0; k < 4; ++k) result[1 + k] = static_cast<uint8_t>(count >> (8 * k));
+    if (!codes_.empty()) memcpy(result.data() + kHeaderSize, codes_.data(), codes_.size());
+    memcpy(result.data() + kHeaderSize + codes_.size(), residuals_.data(), residual_size_);
+    return result;
+}
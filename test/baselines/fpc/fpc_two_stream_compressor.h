@@ -0,0 +1,48 @@
+#ifndef FPC_TWO_STREAM_COMPRESSOR_H
+#define FPC_TWO_STREAM_COMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// FPC with the layout of the original paper: the 4-bit codes and the residual
+// bytes go to two separate byte streams instead of being interleaved through a
+// bit stream, so the decoder can locate every residual before running the
+// predictors.
+//
+// Output: [pred bits : 1][value count : 4][codes : (count + 1) / 2][residuals]
+// Code j is the low nibble of byte j / 2 for even j and the high nibble for odd
+// j. Its top bit selects the DFCM prediction and the low 3 bits index
+// kCodeToByteCount. Residuals are stored little endian, low bytes only.
+class FpcTwoStreamCompressor {
+public:
+    static const uint8_t kCodeToByteCount[8];
+    static const uint8_t kByteCountToCode[9];
+    static constexpr int kHeaderSize = 5;
+
+    explicit FpcTwoStreamCompressor(long pred);
+
+    void addValue(double v);
+    void compress(const double *values, int count);
+    long getCompressedSizeInBits();
+    std::vector<uint8_t> getBytes();
+
+private:
+    long pred_bits_;
+    uint64_t hash_mask_;
+    uint64_t hash_ = 0;
+    uint64_t dhash_ = 0;
+    uint64_t lastval_ = 0;
+    uint64_t pred1_ = 0;
+    uint64_t pred2_ = 0;
+    std::vector<uint64_t> fcm_;
+    std::vector<uint64_t> dfcm_;
+    int count_ = 0;
+    std::vector<uint8_t> codes_;
+    // Always kept 8 bytes longer than residual_size_ so a whole word can be
+    // stored and only the significant bytes kept
+    std::vector<uint8_t> residuals_;
+    size_t residual_size_ = 0;
+};
+
+#endif // FPC_TWO_STREAM_COMPRESSOR_H
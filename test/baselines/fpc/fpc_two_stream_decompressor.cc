@@ -0,0 +1,159 @@
+#include "fpc_two_stream_decompressor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "fpc_two_stream_compressor.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FPC_X86 1
+#endif
+
+namespace {
+
+const uint64_t kByteMask[9] = {
+        0x0000000000000000ULL, 0x00000000000000ffULL, 0x000000000000ffffULL,
+        0x0000000000ffffffULL, 0x00000000ffffffffULL, 0x000000ffffffffffULL,
+        0x0000ffffffffffffULL, 0x00ffffffffffffffULL, 0xffffffffffffffffULL
+};
+
+uint64_t LoadResidual(const uint8_t *src, uint32_t offset, uint8_t length, size_t size) {
+    uint64_t word = 0;
+    if (offset + 8 <= size) {
+        memcpy(&word, src + offset, sizeof(uint64_t));
+        return word & kByteMask[length];
+    }
+    memcpy(&word, src + offset, length);
+    return word;
+}
+
+#ifdef FPC_X86
+bool HasSsse3() {
+    static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    return has_ssse3;
+}
+
+// pshufb controls for two adjacent residuals of l0 and l1 bytes: the first
+// l0 source bytes go to the low word, the next l1 to the high word, and the
+// rest of both words is zeroed (0x80)
+struct PairShuffleTable {
+    alignas(16) uint8_t control[9][9][16];
+
+    PairShuffleTable() {
+        for (int l0 = 0; l0 <= 8; ++l0) {
+            for (int l1 = 0; l1 <= 8; ++l1) {
+                for (int b = 0; b < 8; ++b) {
+                    control[l0][l1][b] = b < l0 ? b : 0x80;
+                    control[l0][l1][8 + b] = b < l1 ? l0 + b : 0x80;
+                }
+            }
+        }
+    }
+};
+
+const PairShuffleTable kPairShuffle;
+
+__attribute__((target("ssse3")))
+int GatherSsse3(const uint8_t *src, size_t size, const uint32_t *offset, const uint8_t *length, int n,
+                uint64_t *out) {
+    int j = 0;
+    for (; j + 1 < n && offset[j] + 16 <= size; j += 2) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + offset[j]));
+        __m128i control = _mm_load_si128(
+                reinterpret_cast<const __m128i *>(kPairShuffle.control[length[j]][length[j + 1]]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j), _mm_shuffle_epi8(bytes, control));
+    }
+    return j;
+}
+#endif
+
+// Fills out[j] with the residual of every value of the chunk
+void GatherResiduals(const uint8_t *src, size_t size, const uint32_t *offset, const uint8_t *length, int n,
+                     uint64_t *out) {
+    int j = 0;
+#ifdef FPC_X86
+    if (HasSsse3()) j = GatherSsse3(src, size, offset, length, n, out);
+#endif
+    for (; j < n; ++j) out[j] = LoadResidual(src, offset[j], length[j], size);
+}
+
+}  // namespace
+
+FpcTwoStreamDecompressor::FpcTwoStreamDecompressor(long pred) {
+    pred_bits_ = pred;
+    hash_mask_ = (1UL << pred) - 1;
+    fcm_.resize(hash_mask_ + 1);
+    dfcm_.resize(hash_mask_ + 1);
+}
+
+int FpcTwoStreamDecompressor::getCount(const uint8_t *data) {
+    uint32_t count = 0;
+    for (int k = 0; k < 4; ++k) count |= static_cast<uint32_t>(data[1 + k]) << (8 * k);
+    return static_cast<int>(count);
+}
+
+int FpcTwoStreamDecompressor::decompress(const uint8_t *data, size_t data_size, double *output) {
+    if (data_size < FpcTwoStreamCompressor::kHeaderSize) {
+        throw std::invalid_argument("[FPC Error]: Truncated two-stream header");
+    }
+    if (data[0] != pred_bits_) {
+        throw std::invalid_argument("[FPC Error]: Two-stream table bits do not match the decompressor");
+    }
+    int count = getCount(data);
+    const uint8_t *codes = data + FpcTwoStreamCompressor::kHeaderSize;
+    size_t code_size = (static_cast<size_t>(count) + 1) / 2;
+    if (FpcTwoStreamCompressor::kHeaderSize + code_size > data_size) {
+        throw std::invalid_argument("[FPC Error]: Truncated two-stream codes");
+    }
+    const uint8_t *residuals = codes + code_size;
+    size_t residual_size = data_size - FpcTwoStreamCompressor::kHeaderSize - code_size;
+
+    std::fill(fcm_.begin(), fcm_.end(), 0);
+    std::fill(dfcm_.begin(), dfcm_.end(), 0);
+    uint64_t hash = 0, dhash = 0, lastval = 0, pred1 = 0, pred2 = 0;
+    uint32_t position = 0;
+
+    for (int base = 0; base < count; base += kChunkSize) {
+        int n = std::min(kChunkSize, count - base);
+        uint8_t select[kChunkSize];
+        for (int j = 0; j < n; ++j) {
+            int i = base + j;
+            uint8_t code = (codes[i >> 1] >> ((i & 1) << 2)) & 0xF;
+            select[j] = code & 0x8;
+            length_[j] = FpcTwoStreamCompressor::kCodeToByteCount[code & 0x7];
+            offset_[j] = position;
+            position += length_[j];
+        }
+        if (position > residual_size) {
+            throw std::invalid_argument("[FPC Error]: Truncated two-stream residuals");
+        }
+        GatherResiduals(residuals, residual_size, offset_, length_, n, residual_);
+
+        for (int j = 0; j < n; ++j) {
+            uint64_t val = residual_[j] ^ (select[j] ? pred2 : pred1);
+            fcm_[hash] = val;
+            hash = ((hash << 6) ^ (val >> 48)) & hash_mask_;
+            pred1 = fcm_[hash];
+
+            uint64_t stride = val - lastval;
+            dfcm_[dhash] = stride;
+            dhash = ((dhash << 2) ^ (stride >> 40)) & hash_mask_;
+            pred2 = val + dfcm_[dhash];
+            lastval = val;
+
+            memcpy(output + base + j, &val, sizeof(double));
+        }
+    }
+    return count;
+}
+
+std::vector<double> FpcTwoStreamDecompressor::decompress(const std::vector<uint8_t> &data) {
+    if (data.size() < FpcTwoStreamCompressor::kHeaderSize) {
+        throw std::invalid_argument("[FPC Error]: Truncated two-stream header");
+    }
+    std::vector<double> result(getCount(data.data()));
+    decompress(data.data(), data.size(), result.data());
+    return result;
+}
@@ -0,0 +1,35 @@
+#ifndef FPC_TWO_STREAM_DECOMPRESSOR_H
+#define FPC_TWO_STREAM_DECOMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Decoder for FpcTwoStreamCompressor. Values are decoded in chunks: the codes
+// of a chunk give every residual length and offset up front, the residuals are
+// gathered into 64-bit words with byte shuffles, two values per shuffle, and
+// only the FCM/DFCM predictor pass stays serial. The predictor tables are
+// allocated once for the table bits the streams were written with.
+class FpcTwoStreamDecompressor {
+public:
+    explicit FpcTwoStreamDecompressor(long pred);
+
+    static int getCount(const uint8_t *data);
+
+    // Writes getCount(data) values to output and returns that count
+    int decompress(const uint8_t *data, size_t data_size, double *output);
+    std::vector<double> decompress(const std::vector<uint8_t> &data);
+
+private:
+    static constexpr int kChunkSize = 256;
+
+    long pred_bits_;
+    uint64_t hash_mask_;
+    std::vector<uint64_t> fcm_;
+    std::vector<uint64_t> dfcm_;
+    uint64_t residual_[kChunkSize];
+    uint32_t offset_[kChunkSize];
+    uint8_t length_[kChunkSize];
+};
+
+#endif // FPC_TWO_STREAM_DECOMPRESSOR_H
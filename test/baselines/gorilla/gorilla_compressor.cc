@@ -1,38 +1,54 @@
 #include "gorilla_compressor.h"
 
-GorillaCompressor::GorillaCompressor(int capacity) {
-    output_bit_stream_ = std::make_unique<OutputBitStream>(2 * capacity * sizeof(double));
+template<typename T>
+BasicGorillaCompressor<T>::BasicGorillaCompressor(int capacity, bool with_stats) : header_(with_stats) {
+    output_bit_stream_ = std::make_unique<OutputBitStream>(
+            2 * capacity * sizeof(T) + header_.size());
+    reset();
 }
 
-void GorillaCompressor::addValue(double v) {
-    uint64_t raw_binary = Double::DoubleToLongBits(v);
+template<typename T>
+void BasicGorillaCompressor<T>::reset() {
+    output_bit_stream_->Refresh();
+    header_.Clear();
+    // Room for the header, stored by get_compress_pack()
+    for (size_t i = 0; i < header_.size(); ++i) {
+        output_bit_stream_->WriteInt(0, 8);
+    }
+    compress_size_in_bits_ = header_.size() * 8;
+    first_ = true;
+    pr_value_ = 0;
+    pr_lead_ = std::numeric_limits<int>::max();
+    pr_trail_ = 0;
+}
+
+template<typename T>
+void BasicGorillaCompressor<T>::addValue(T v) {
+    header_.Add(v);
+    Bits raw_binary = Traits::ToBits(v);
     if (first_) {
         first_ = false;
-        compress_size_in_bits_ += output_bit_stream_->WriteLong(raw_binary, 64);
+        compress_size_in_bits_ += output_bit_stream_->WriteLong(raw_binary, Traits::kBits);
     } else {
-        uint64_t xored_value = pr_value_ ^ raw_binary;
+        Bits xored_value = pr_value_ ^ raw_binary;
         if (xored_value == 0) {
             compress_size_in_bits_ += output_bit_stream_->WriteBit(false);
         } else {
             compress_size_in_bits_ += output_bit_stream_->WriteBit(true);
-            int lead = __builtin_clzll(xored_value);
+            int lead = Traits::Clz(xored_value);
             if (lead >= 32) lead = 31;
-            int trail = __builtin_ctzll(xored_value);
+            int trail = Traits::Ctz(xored_value);
             if (lead >= pr_lead_ && trail >= pr_trail_) {
                 compress_size_in_bits_ += output_bit_stream_->WriteBit(false);
-                int significant_bits = 64 - pr_lead_ - pr_trail_;
+                int significant_bits = Traits::kBits - pr_lead_ - pr_trail_;
                 compress_size_in_bits_ += output_bit_stream_->WriteLong(
                         xored_value >> pr_trail_, significant_bits);
             } else {
                 compress_size_in_bits_ += output_bit_stream_->WriteBit(true);
                 compress_size_in_bits_ += output_bit_stream_->WriteInt(lead, 5);
-                int significant_bits = 64 - lead - trail;
-                if (significant_bits == 64) {
-                    compress_size_in_bits_ += output_bit_stream_->WriteInt(0, 6);
-                } else {
-                    compress_size_in_bits_ += output_bit_stream_->WriteInt(
-                            significant_bits, 6);
-                }
+                int significant_bits = Traits::kBits - lead - trail;
+                compress_size_in_bits_ += output_bit_stream_->WriteInt(
+                        significant_bits & (Traits::kBits - 1), Traits::kBitsLog2);
                 compress_size_in_bits_ += output_bit_stream_->WriteLong(
                         xored_value >> trail, significant_bits);
                 pr_lead_ = lead;
@@ -44,18 +60,23 @@ void GorillaCompressor::addValue(double v) {
     pr_value_ = raw_binary;
 }
 
-void GorillaCompressor::close() {
-    addValue(std::numeric_limits<double>::quiet_NaN());
+template<typename T>
+void BasicGorillaCompressor<T>::close() {
     output_bit_stream_->Flush();
 }
 
-Array<uint8_t> GorillaCompressor::get_compress_pack() {
+template<typename T>
+Array<uint8_t> BasicGorillaCompressor<T>::get_compress_pack() {
     compress_pack_ = output_bit_stream_->GetBuffer(std::ceil
             (compress_size_in_bits_ / 8.0));
+    header_.Store(compress_pack_.begin());
     return compress_pack_;
 }
 
-long GorillaCompressor::get_compress_size_in_bits() {
+template<typename T>
+long BasicGorillaCompressor<T>::get_compress_size_in_bits() {
     return compress_size_in_bits_;
 }
 
+template class BasicGorillaCompressor<double>;
+template class BasicGorillaCompressor<float>;
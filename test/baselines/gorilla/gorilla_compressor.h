@@ -6,36 +6,58 @@
 #include <limits>
 #include <memory>
 #include "output_bit_stream.h"
+#include "stream_header.h"
+#include "float_traits.h"
 #include "array.h"
-#include "double.h"
 
-class GorillaCompressor {
+// Gorilla over the bits of a T, instantiated for double and float in
+// gorilla_compressor.cc. The first value takes kBits bits and a new window
+// stores lead:5 and significant bits:kBitsLog2, where 0 stands for kBits. The
+// stream starts with a bitstream::StreamHeader holding the value count;
+// with_stats also stores the first/last/min/max of the block there.
+template<typename T>
+class BasicGorillaCompressor {
 public:
-    explicit GorillaCompressor(int capacity);
+    explicit BasicGorillaCompressor(int capacity, bool with_stats = false);
 
-    void addValue(double v);
+    void addValue(T v);
 
     void close();
 
+    // Starts a new block
+    void reset();
+
     Array<uint8_t> get_compress_pack();
 
     long get_compress_size_in_bits();
 
 private:
+    using Traits = bitstream::FloatTraits<T>;
+
+    using Bits = typename Traits::Bits;
+
     std::unique_ptr<OutputBitStream> output_bit_stream_;
 
+    bitstream::StreamHeader header_;
+
     Array<uint8_t> compress_pack_ = Array<uint8_t>(0);
 
     long compress_size_in_bits_ = 0;
 
     bool first_ = true;
 
-    uint64_t pr_value_ = 0;
+    Bits pr_value_ = 0;
 
     int pr_lead_ = std::numeric_limits<int>::max();
 
     int pr_trail_ = 0;
 };
 
+extern template class BasicGorillaCompressor<double>;
+extern template class BasicGorillaCompressor<float>;
+
+using GorillaCompressor = BasicGorillaCompressor<double>;
+using GorillaCompressor32 = BasicGorillaCompressor<float>;
+
 
 #endif // GORILLA_COMPRESSOR_H
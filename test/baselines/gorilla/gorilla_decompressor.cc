@@ -1,34 +1,52 @@
 #include "gorilla_decompressor.h"
 
-std::vector<double> GorillaDecompressor::decompress(const Array<uint8_t>& compress_pack) {
-    input_bit_stream_->SetBuffer(compress_pack);
-    std::vector<double> values;
-    double cur_value;
-    while (!std::isnan(cur_value = nextValue())) {
-        values.emplace_back(cur_value);
+template<typename T>
+bitstream::StreamHeader BasicGorillaDecompressor<T>::header(const Array<uint8_t>& compress_pack) {
+    return bitstream::StreamHeader::Load(compress_pack.begin(), compress_pack.length());
+}
+
+template<typename T>
+int BasicGorillaDecompressor<T>::decompress(const Array<uint8_t>& compress_pack, T *output) {
+    bitstream::StreamHeader stream_header = header(compress_pack);
+    int count = static_cast<int>(stream_header.count);
+    if (count == 0) return 0;
+    input_bit_stream_->SetBuffer(compress_pack.begin() + stream_header.size(),
+                                 compress_pack.length() - stream_header.size());
+    pr_value_ = input_bit_stream_->ReadLong(Traits::kBits);
+    pr_lead_ = std::numeric_limits<int>::max();
+    pr_trail_ = 0;
+    output[0] = Traits::FromBits(pr_value_);
+    for (int i = 1; i < count; ++i) {
+        output[i] = nextValue();
     }
+    return count;
+}
+
+template<typename T>
+std::vector<T> BasicGorillaDecompressor<T>::decompress(const Array<uint8_t>& compress_pack) {
+    std::vector<T> values(header(compress_pack).count);
+    decompress(compress_pack, values.data());
     return values;
 }
 
-double GorillaDecompressor::nextValue() {
-    if (first_) {
-        first_ = false;
-        pr_value_ = input_bit_stream_->ReadLong(64);
-    } else {
+template<typename T>
+T BasicGorillaDecompressor<T>::nextValue() {
+    if (input_bit_stream_->ReadBit() == 1) {
         if (input_bit_stream_->ReadBit() == 1) {
-            if (input_bit_stream_->ReadBit() == 1) {
-                pr_lead_ = input_bit_stream_->ReadInt(5);
-                int significant_bits = input_bit_stream_->ReadInt(6);
-                if (significant_bits == 0) significant_bits = 64;
-                pr_trail_ = 64 - significant_bits - pr_lead_;
-            }
-            uint64_t value = input_bit_stream_->ReadLong(
-                    64 - pr_lead_ - pr_trail_);
-            value <<= pr_trail_;
-            value = pr_value_ ^ value;
-            pr_value_ = value;
+            pr_lead_ = input_bit_stream_->ReadInt(5);
+            int significant_bits = input_bit_stream_->ReadInt(Traits::kBitsLog2);
+            if (significant_bits == 0) significant_bits = Traits::kBits;
+            pr_trail_ = Traits::kBits - significant_bits - pr_lead_;
         }
-        // else the same
+        Bits value = input_bit_stream_->ReadLong(
+                Traits::kBits - pr_lead_ - pr_trail_);
+        value <<= pr_trail_;
+        value = pr_value_ ^ value;
+        pr_value_ = value;
     }
-    return Double::LongBitsToDouble(pr_value_);
+    // else the same
+    return Traits::FromBits(pr_value_);
 }
+
+template class BasicGorillaDecompressor<double>;
+template class BasicGorillaDecompressor<float>;
@@ -4,27 +4,46 @@
 
 #include <limits>
 #include <memory>
+#include <vector>
 #include "array.h"
 #include "input_bit_stream.h"
-#include "double.h"
+#include "stream_header.h"
+#include "float_traits.h"
 
-class GorillaDecompressor {
+// Decoder for BasicGorillaCompressor<T>; instantiated for double and float in
+// gorilla_decompressor.cc.
+template<typename T>
+class BasicGorillaDecompressor {
 public:
-    GorillaDecompressor() = default;
+    BasicGorillaDecompressor() = default;
 
-    std::vector<double> decompress(const Array<uint8_t>& compress_pack);
+    // The header of a stream, e.g. to size the output before decompressing
+    static bitstream::StreamHeader header(const Array<uint8_t>& compress_pack);
+
+    // Writes header(compress_pack).count values to output, returns the count
+    int decompress(const Array<uint8_t>& compress_pack, T *output);
+
+    std::vector<T> decompress(const Array<uint8_t>& compress_pack);
 
 private:
-    uint64_t pr_value_ = 0;
+    using Traits = bitstream::FloatTraits<T>;
+
+    using Bits = typename Traits::Bits;
+
+    Bits pr_value_ = 0;
     int pr_lead_ = std::numeric_limits<int>::max();
     int pr_trail_ = 0;
 
-    bool first_ = true;
-
     std::unique_ptr<InputBitStream> input_bit_stream_ = std::make_unique<InputBitStream>();
 
-    double nextValue();
+    T nextValue();
 };
 
+extern template class BasicGorillaDecompressor<double>;
+extern template class BasicGorillaDecompressor<float>;
+
+using GorillaDecompressor = BasicGorillaDecompressor<double>;
+using GorillaDecompressor32 = BasicGorillaDecompressor<float>;
+
 
 #endif // GORILLA_DECOMPRESSOR_H
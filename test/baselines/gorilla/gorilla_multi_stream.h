@@ -0,0 +1,208 @@
+#ifndef GORILLA_MULTI_STREAM_H
+#define GORILLA_MULTI_STREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "array.h"
+#include "bit_reader.h"
+#include "double.h"
+#include "gorilla_compressor.h"
+#include "stream_header.h"
+
+// Gorilla over kStreams interleaved sub-streams: value i goes to sub-stream
+// i % kStreams, and each sub-stream is an ordinary Gorilla chain with its own
+// predictor. A block decodes as kStreams independent dependency chains, which
+// the out-of-order core overlaps.
+//
+//   [StreamHeader][kStreams:1][sub-stream bytes: 4 LE each][sub-streams]
+//   [zero padding: kPadding]
+//
+// A sub-stream is the Gorilla bit stream of its values, without a header.
+template<int kStreams>
+class GorillaMultiStreamCompressor {
+public:
+    static_assert(kStreams > 0 && kStreams < 256, "stream count must fit in a byte");
+
+    // Lets the decoder read 9 bytes at any position of the last sub-stream
+    static constexpr size_t kPadding = 9;
+
+    explicit GorillaMultiStreamCompressor(int capacity, bool with_stats = false) : header_(with_stats) {
+        for (auto &stream : streams_) {
+            stream = std::make_unique<GorillaCompressor>(capacity / kStreams + 1);
+        }
+    }
+
+    void addValue(double v) {
+        streams_[next_]->addValue(v);
+        header_.Add(v);
+        if (++next_ == kStreams) next_ = 0;
+    }
+
+    void close() {
+        for (auto &stream : streams_) stream->close();
+    }
+
+    // Starts a new block
+    void reset() {
+        for (auto &stream : streams_) stream->reset();
+        header_.Clear();
+        next_ = 0;
+    }
+
+    Array<uint8_t> get_compress_pack() {
+        Array<uint8_t> packs[kStreams];
+        size_t total = header_.size() + 1 + 4 * kStreams + kPadding;
+        for (int s = 0; s < kStreams; ++s) {
+            packs[s] = streams_[s]->get_compress_pack();
+            total += packs[s].length() - kSubHeaderSize;
+        }
+        compress_pack_ = Array<uint8_t>(static_cast<int>(total));
+        uint8_t *out = compress_pack_.begin();
+        header_.Store(out);
+        out += header_.size();
+        *out++ = kStreams;
+        for (int s = 0; s < kStreams; ++s) {
+            uint32_t bytes = packs[s].length() - kSubHeaderSize;
+            std::memcpy(out, &bytes, sizeof(bytes));
+            out += sizeof(bytes);
+        }
+        for (int s = 0; s < kStreams; ++s) {
+            std::memcpy(out, packs[s].begin() + kSubHeaderSize, packs[s].length() - kSubHeaderSize);
+            out += packs[s].length() - kSubHeaderSize;
+        }
+        return compress_pack_;
+    }
+
+    // The bytes of get_compress_pack(), in bits
+    long get_compress_size_in_bits() {
+        long bits = (header_.size() + 1 + 4 * kStreams + kPadding) * 8;
+        for (auto &stream : streams_) {
+            bits += (stream->get_compress_size_in_bits() + 7) / 8 * 8 - kSubHeaderSize * 8;
+        }
+        return bits;
+    }
+
+private:
+    // The header of each sub-stream compressor, which the block header replaces
+    static constexpr size_t kSubHeaderSize = bitstream::StreamHeader::kBaseSize;
+
+    std::unique_ptr<GorillaCompressor> streams_[kStreams];
+
+    bitstream::StreamHeader header_;
+
+    int next_ = 0;
+
+    Array<uint8_t> compress_pack_ = Array<uint8_t>(0);
+};
+
+template<int kStreams>
+class GorillaMultiStreamDecompressor {
+public:
+    static_assert(kStreams > 0 && kStreams < 256, "stream count must fit in a byte");
+
+    static bitstream::StreamHeader header(const Array<uint8_t> &compress_pack) {
+        return bitstream::StreamHeader::Load(compress_pack.begin(), compress_pack.length());
+    }
+
+    // Writes header(compress_pack).count values to output, returns the count
+    int decompress(const Array<uint8_t> &compress_pack, double *output) {
+        bitstream::StreamHeader stream_header = header(compress_pack);
+        size_t fixed = stream_header.size() + 1 + 4 * kStreams + GorillaMultiStreamCompressor<kStreams>::kPadding;
+        if (static_cast<size_t>(compress_pack.length()) < fixed) {
+            throw std::runtime_error("[Gorilla Error]: Stream is too short");
+        }
+        const uint8_t *in = compress_pack.begin() + stream_header.size();
+        const uint8_t *end = compress_pack.begin() + compress_pack.length()
+                             - GorillaMultiStreamCompressor<kStreams>::kPadding;
+        if (*in != kStreams) throw std::runtime_error("[Gorilla Error]: Stream count does not match");
+        // Chains are locals so that the compiler can keep them in registers
+        Chain chains[kStreams];
+        const uint8_t *payload = in + 1 + 4 * kStreams;
+        for (int s = 0; s < kStreams; ++s) {
+            uint32_t bytes;
+            std::memcpy(&bytes, in + 1 + 4 * s, sizeof(bytes));
+            if (payload + bytes > end) throw std::runtime_error("[Gorilla Error]: Truncated sub-stream");
+            chains[s].Reset(payload);
+            payload += bytes;
+        }
+
+        int count = static_cast<int>(stream_header.count);
+        int first = count < kStreams ? count : kStreams;
+        for (int s = 0; s < first; ++s) output[s] = chains[s].First();
+        int i = first;
+        // One value from every chain per round
+        for (; i + kStreams <= count; i += kStreams) {
+#pragma GCC unroll 16
+            for (int s = 0; s < kStreams; ++s) output[i + s] = chains[s].Next();
+        }
+        for (int s = 0; i < count; ++s, ++i) output[i] = chains[s].Next();
+        return count;
+    }
+
+    std::vector<double> decompress(const Array<uint8_t> &compress_pack) {
+        std::vector<double> values(header(compress_pack).count);
+        decompress(compress_pack, values.data());
+        return values;
+    }
+
+private:
+    // GorillaDecompressor::nextValue, with its own reader: the block padding
+    // lets every read be one unaligned load plus a byte, without bounds
+    // checks. It selects on the control bits instead of branching: those
+    // branches mispredict often, and every miss would also flush the other
+    // chains of the round.
+    struct Chain {
+        const uint8_t *data = nullptr;
+        size_t pos = 0;
+        uint64_t pr_value = 0;
+        int pr_lead = 0;
+        int pr_trail = 0;
+
+        void Reset(const uint8_t *new_data) {
+            data = new_data;
+            pos = 0;
+            pr_value = 0;
+            pr_lead = 0;
+            pr_trail = 0;
+        }
+
+        double First() {
+            pr_value = Peek64(data, pos);
+            pos += 64;
+            return Double::LongBitsToDouble(pr_value);
+        }
+
+        BITSTREAM_INLINE double Next() {
+            // '0', '10' or '11' + lead:5 + significant bits:6
+            uint32_t control = static_cast<uint32_t>(Peek64(data, pos) >> 51);
+            bool changed = control >> 12;
+            bool update = (control >> 11) == 3;
+            int lead = static_cast<int>(control >> 6) & 0x1f;
+            int significant_bits = static_cast<int>(control & 0x3f);
+            significant_bits = significant_bits == 0 ? 64 : significant_bits;
+            pr_lead = update ? lead : pr_lead;
+            pr_trail = update ? 64 - significant_bits - lead : pr_trail;
+            pos += update ? 13 : changed ? 2 : 1;
+            int len = changed ? 64 - pr_lead - pr_trail : 0;
+            uint64_t bits = Peek64(data, pos);
+            bits = len == 0 ? 0 : bits >> (64 - len);
+            pos += len;
+            pr_value ^= bits << pr_trail;
+            return Double::LongBitsToDouble(pr_value);
+        }
+    };
+
+    // The 64 bits at bit position pos
+    BITSTREAM_INLINE static uint64_t Peek64(const uint8_t *data, size_t pos) {
+        const uint8_t *byte = data + (pos >> 3);
+        int shift = static_cast<int>(pos & 7);
+        return (bitstream::LoadBigEndian64(byte) << shift) | (static_cast<uint64_t>(byte[8]) >> (8 - shift));
+    }
+};
+
+#endif // GORILLA_MULTI_STREAM_H
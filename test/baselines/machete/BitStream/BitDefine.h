@@ -1,6 +0,0 @@
-#pragma once
-
-#define DEBUG
-
-#define SIZE_IN_BYTE(x) (((x) + 3)/4)
-#define SIZE_IN_BIT(x) (((x) + 31)/32)
@@ -67,10 +67,17 @@ enum Encoder {huffman, huffmanC, ovlq, hybrid};
 
 ssize_t lorenzo1_diff(double* input, ssize_t len, int32_t* output, double error, uint8_t** predictor_out, ssize_t* psize);
 ssize_t lorenzo1_correct(int32_t* input, ssize_t len, double* output, uint8_t* predictor_out, ssize_t psize);
+ssize_t lorenzo1_diff(float* input, ssize_t len, int32_t* output, double error, uint8_t** predictor_out, ssize_t* psize);
+ssize_t lorenzo1_correct(int32_t* input, ssize_t len, float* output, uint8_t* predictor_out, ssize_t psize);
 
 enum Predictor {lorenzo1};
 
 template<Predictor p, Encoder e>
 ssize_t machete_compress(double* input, ssize_t len, uint8_t** output, double error);
 template<Predictor p, Encoder e>
-ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output);
\ No newline at end of file
+ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output);
+// Single precision: the same stream layout, with float raw values and outliers
+template<Predictor p, Encoder e>
+ssize_t machete_compress(float* input, ssize_t len, uint8_t** output, double error);
+template<Predictor p, Encoder e>
+ssize_t machete_decompress(uint8_t* input, ssize_t size, float* output);
\ No newline at end of file
@@ -3,8 +3,8 @@
 #include <stack>
 #include <cstdlib>
 
-#include "BitStream/BitReader.h"
-#include "BitStream/BitWriter.h"
+#include "bit_reader.h"
+#include "bit_writer.h"
 
 static bool great_on_cnt(HufTree *n0, HufTree *n1) {
         return n0->cnt > n1->cnt;
@@ -138,13 +138,12 @@ ssize_t huffman_store_canonical_codebook(EncodeCodebook &codebook, int32_t* vals
 
 ssize_t huffman_store_code(EncodeCodebook &codebook, int32_t* input, int32_t len, uint8_t* output, ssize_t osize) {
         if (LIKELY(codebook.size() > 1)) {
-                BitWriter writer;
-                initBitWriter(&writer, reinterpret_cast<uint32_t*>(output), osize/4);
+                bitstream::BitWriter writer(output, osize);
                 for (int i = 0; i < len; i++) {
                         auto e = codebook[input[i]];
-                        write(&writer, e.code, e.bitlen);
+                        writer.Write(e.code, e.bitlen);
                 }
-                flush(&writer);
+                writer.Flush();
         }
         return 0;
 }
@@ -245,12 +244,11 @@ ssize_t huffman_build_decode_codebook_canonical(int32_t* vals, int16_t* bitlens,
 
 ssize_t huffman_decode_data(uint8_t* input, uint32_t code_size, DecodeCodebook codebook, ssize_t index_bitlen, int32_t* output, int32_t olen) {
         if (LIKELY(index_bitlen)) {
-                BitReader reader;
-                initBitReader(&reader, reinterpret_cast<uint32_t*>(input), code_size/4);
+                bitstream::BitReader reader(input, code_size);
                 for (int i = 0; i < olen; i++) {
-                        int code = peek(&reader, index_bitlen);
+                        int code = reader.Peek(index_bitlen);
                         output[i] = codebook[code].val;
-                        forward(&reader, codebook[code].bitlen);
+                        reader.Forward(codebook[code].bitlen);
                 }
         } else {
                 for (int i = 0; i < olen; i++) {
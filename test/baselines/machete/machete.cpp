@@ -14,15 +14,15 @@ typedef struct __attribute__((__packed__)) {
         };
 } MacheteHeader;
 
-template<Predictor p>
-ssize_t predict_diff_phase(double* input, ssize_t len, int32_t* output, double error, uint8_t** predictor_out, ssize_t* psize) {
+template<Predictor p, typename T>
+ssize_t predict_diff_phase(T* input, ssize_t len, int32_t* output, double error, uint8_t** predictor_out, ssize_t* psize) {
         switch (p) {
                 case lorenzo1: return lorenzo1_diff(input, len, output, error, predictor_out, psize);
         }
         return -1;
 }
-template<Predictor p>
-ssize_t predict_correct_phase(int32_t* input, ssize_t len, double* output, uint8_t* predictor_out, ssize_t psize) {
+template<Predictor p, typename T>
+ssize_t predict_correct_phase(int32_t* input, ssize_t len, T* output, uint8_t* predictor_out, ssize_t psize) {
         switch (p) {
                 case lorenzo1: return lorenzo1_correct(input, len, output, predictor_out, psize);
         }
@@ -49,10 +49,11 @@ ssize_t decode_phase(uint8_t* input, ssize_t size, int32_t* output) {
         return -1;
 }
 
-template<Predictor p, Encoder e>
-ssize_t machete_compress(double* input, ssize_t len, uint8_t** output, double error) {
+// Shared by the double and float entry points, T is the value type
+template<Predictor p, Encoder e, typename T>
+ssize_t compress_values(T* input, ssize_t len, uint8_t** output, double error) {
         if (UNLIKELY(len < 10)) {//do not compress if too short, headers are too costy in this case.
-                ssize_t data_size = sizeof(double) * len;
+                ssize_t data_size = sizeof(T) * len;
                 *output = reinterpret_cast<uint8_t*>(malloc(sizeof(uint32_t) + data_size));
                 MacheteHeader* header = reinterpret_cast<MacheteHeader*>(*output);
                 header->data_len = len;
@@ -101,11 +102,11 @@ ssize_t machete_getlen(uint8_t* compressed) {
         return READ_AS_UINT32(compressed);
 }
 
-template<Predictor p, Encoder e>
-ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output) {
+template<Predictor p, Encoder e, typename T>
+ssize_t decompress_values(uint8_t* input, ssize_t size, T* output) {
         MacheteHeader* header = reinterpret_cast<MacheteHeader*>(input);
         if (UNLIKELY(header->data_len < 10)) {
-                __builtin_memcpy(output, input+4, sizeof(double) * header->data_len);
+                __builtin_memcpy(output, input+4, sizeof(T) * header->data_len);
                 return header->data_len;
         }
 
@@ -119,13 +120,45 @@ ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output) {
         return header->data_len;
 }
 
-decltype(&machete_compress<lorenzo1,huffman>) _func_compress[] = {
+template<Predictor p, Encoder e>
+ssize_t machete_compress(double* input, ssize_t len, uint8_t** output, double error) {
+        return compress_values<p, e>(input, len, output, error);
+}
+
+template<Predictor p, Encoder e>
+ssize_t machete_compress(float* input, ssize_t len, uint8_t** output, double error) {
+        return compress_values<p, e>(input, len, output, error);
+}
+
+template<Predictor p, Encoder e>
+ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output) {
+        return decompress_values<p, e>(input, size, output);
+}
+
+template<Predictor p, Encoder e>
+ssize_t machete_decompress(uint8_t* input, ssize_t size, float* output) {
+        return decompress_values<p, e>(input, size, output);
+}
+
+ssize_t (*_func_compress[])(double*, ssize_t, uint8_t**, double) = {
+        machete_compress<lorenzo1, huffman>,
+        machete_compress<lorenzo1, ovlq>,
+        machete_compress<lorenzo1, hybrid>,
+};
+
+ssize_t (*_func_decompress[])(uint8_t*, ssize_t, double*) = {
+        machete_decompress<lorenzo1, huffman>,
+        machete_decompress<lorenzo1, ovlq>,
+        machete_decompress<lorenzo1, hybrid>,
+};
+
+ssize_t (*_func_compress_32[])(float*, ssize_t, uint8_t**, double) = {
         machete_compress<lorenzo1, huffman>,
         machete_compress<lorenzo1, ovlq>,
         machete_compress<lorenzo1, hybrid>,
 };
 
-decltype(&machete_decompress<lorenzo1, huffman>) _func_decompress[] = {
+ssize_t (*_func_decompress_32[])(uint8_t*, ssize_t, float*) = {
         machete_decompress<lorenzo1, huffman>,
         machete_decompress<lorenzo1, ovlq>,
         machete_decompress<lorenzo1, hybrid>,
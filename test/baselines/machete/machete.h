@@ -8,3 +8,8 @@ template<Predictor p, Encoder e>
 ssize_t machete_compress(double* input, ssize_t len, uint8_t** output, double error);
 template<Predictor p, Encoder e>
 ssize_t machete_decompress(uint8_t* input, ssize_t size, double* output);
+// Single precision: the same stream layout, with float raw values and outliers
+template<Predictor p, Encoder e>
+ssize_t machete_compress(float* input, ssize_t len, uint8_t** output, double error);
+template<Predictor p, Encoder e>
+ssize_t machete_decompress(uint8_t* input, ssize_t size, float* output);
@@ -2,8 +2,8 @@
 #include <stdlib.h>
 #include <assert.h>
 #include "defs.h"
-#include "BitStream/BitWriter.h"
-#include "BitStream/BitReader.h"
+#include "bit_reader.h"
+#include "bit_writer.h"
 
 #define DIV_UP(x,b)     (((x) + (1<<(b)) - 1) >> (b))
 #define ALIGN_UP(x,b)   (((x) + (1 << (b)) - 1) & ~((1 << (b))-1))
@@ -131,22 +131,21 @@ ssize_t ovlq_encode(int32_t* input, ssize_t len, uint8_t** output) {
         header->len = len;
         header->mapping = optimal_mapping;
 
-        BitWriter writer;
-        initBitWriter(&writer, reinterpret_cast<uint32_t*>(header->payload), (osize - sizeof(OVLQ_Header))/sizeof(uint32_t));
+        bitstream::BitWriter writer(reinterpret_cast<uint8_t*>(header->payload), osize - sizeof(OVLQ_Header));
         if (table == nullptr) {
                 int bitlen = __builtin_ctz(optimal_mapping) + 1;
                 for (int i = 0; i < len; i++) {
-                        write(&writer, input[i], bitlen);
+                        writer.Write(input[i], bitlen);
                 }
         } else {
                 for (int i = 0; i < len; i++) {
                         auto entry = &table[data_min_bitlen[i]];
-                        write(&writer, entry->flag, entry->flen);
-                        write(&writer, input[i], entry->dlen);
+                        writer.Write(entry->flag, entry->flen);
+                        writer.Write(input[i], entry->dlen);
                 }
                 delete[] table;
         }
-        flush(&writer);
+        writer.Flush();
         delete[] data_min_bitlen;
         return osize;
 }
@@ -183,14 +182,13 @@ OVLQ_DecodeTable ovlq_build_decode_table_with_mapping(int64_t mapping, ssize_t &
 ssize_t ovlq_decode(uint8_t* input, ssize_t size, int32_t* output) {
         OVLQ_Header *header = reinterpret_cast<OVLQ_Header*>(input);
         uint64_t mapping = static_cast<uint64_t>(header->mapping) << 1;
-        BitReader reader;
-        initBitReader(&reader, reinterpret_cast<uint32_t*>(header->payload), (size - sizeof(OVLQ_Header))/sizeof(uint32_t));
+        bitstream::BitReader reader(reinterpret_cast<uint8_t*>(header->payload), size - sizeof(OVLQ_Header));
         int32_t level = __builtin_popcountll(mapping);
         if (level == 1) {
                 int32_t bitlen = __builtin_ctzll(mapping);
                 for (int i = 0; i < header->len; i++) {
-                        int32_t d = peek(&reader, bitlen);
-                        forward(&reader, bitlen);
+                        int32_t d = reader.Peek(bitlen);
+                        reader.Forward(bitlen);
                         output[i] = d << (32 - bitlen) >> (32 - bitlen);
                 }
                 return header->len;
@@ -198,11 +196,11 @@ ssize_t ovlq_decode(uint8_t* input, ssize_t size, int32_t* output) {
                 ssize_t index_bitlen;
                 OVLQ_DecodeTable table = ovlq_build_decode_table_with_mapping(mapping, index_bitlen);
                 for (int i = 0; i < header->len; i++) {
-                        int index = peek(&reader, index_bitlen);
+                        int index = reader.Peek(index_bitlen);
                         auto entry = table[index];
-                        forward(&reader, entry.flen);
-                        int data = peek(&reader, entry.dlen);
-                        forward(&reader, entry.dlen);
+                        reader.Forward(entry.flen);
+                        int data = reader.Peek(entry.dlen);
+                        reader.Forward(entry.dlen);
                         output[i] = data << (32 - entry.dlen) >> (32 - entry.dlen);
                 }
                 delete[] table;
@@ -1,5 +1,6 @@
 #include "defs.h"
 #include <stdlib.h>
+#include <cmath>
 #include <vector>
 
 struct LorenzoConfig {
@@ -8,6 +9,14 @@ struct LorenzoConfig {
         double outiers[0];
 };
 
+// The float stream keeps the error as a float, so that both sides derive the
+// same step from it, and float outliers
+struct LorenzoConfig32 {
+        float error;
+        float first;
+        float outiers[0];
+};
+
 static inline int32_t diff(const double &data, const double &predicted, const DOUBLE &e, const double &e2, const double &max_diff) {
         DOUBLE d = {.d = data - predicted};
         DOUBLE d_abs = {.i = d.i & ~DOUBLE_SIGN_BIT};
@@ -69,3 +78,63 @@ ssize_t lorenzo1_correct(int32_t* input, ssize_t len, double* output, uint8_t* p
 
 
 
+
+
+// The float predictor runs in double, as the decoder does, and only rounds its
+// output to float. A step whose rounded reconstruction leaves the bound becomes
+// an outlier, so the bound holds for the float values.
+ssize_t lorenzo1_diff(float* input, ssize_t len, int32_t* output, double error, uint8_t** predictor_out, ssize_t* psize) {
+        std::vector<float> outier;
+        float stored_error = static_cast<float>(error);
+        DOUBLE e = {.d= stored_error * 0.999};
+        double e2 = e.d * 2;
+        double max_diff = e2 * INT32_MAX;
+        double predicted = input[0];
+        for (int i = 1; i < len; i++) {
+                *output = diff(input[i], predicted, e, e2, max_diff);
+                if (LIKELY(*output != INT32_MIN)) {
+                        double next = predicted + *output * e2;
+                        if (LIKELY(std::fabs(static_cast<float>(next) - input[i]) <= error)) {
+                                predicted = next;
+                                output++;
+                                continue;
+                        }
+                        *output = INT32_MIN;
+                }
+                outier.push_back(input[i]);
+                predicted = input[i];
+                output++;
+        }
+        *psize = sizeof(LorenzoConfig32) + outier.size() * sizeof(float);
+        *predictor_out = reinterpret_cast<uint8_t*>(malloc(*psize));
+        LorenzoConfig32* config = reinterpret_cast<LorenzoConfig32*>(*predictor_out);
+        config->error = stored_error;
+        config->first = input[0];
+        __builtin_memcpy(config->outiers, outier.data(), outier.size() * sizeof(float));
+        return len - 1;
+}
+
+ssize_t lorenzo1_correct(int32_t* input, ssize_t len, float* output, uint8_t* predictor_out, ssize_t psize) {
+        LorenzoConfig32* config = reinterpret_cast<LorenzoConfig32*>(predictor_out);
+        double e2 = config->error * 0.999 * 2;
+        float* outier = config->outiers;
+
+        double predicted = config->first;
+        output[0] = config->first;
+        if (psize == sizeof(LorenzoConfig32)) {
+                for (int i = 0; i < len; i++) {
+                        predicted += e2 * input[i];
+                        output[i+1] = static_cast<float>(predicted);
+                }
+        } else {
+                for (int i = 0; i < len; i++) {
+                        if (UNLIKELY(input[i] == INT32_MIN)) {
+                                predicted = *outier++;
+                        } else {
+                                predicted += e2 * input[i];
+                        }
+                        output[i+1] = static_cast<float>(predicted);
+                }
+        }
+        return len + 1;
+}
@@ -0,0 +1,74 @@
+#include "mantissa_truncation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "float_traits.h"
+
+namespace {
+
+// Rounds value to nearest, ties away from zero, with the low drop mantissa
+// bits cleared. The carry of the rounding may reach the exponent.
+template<typename T>
+T RoundMantissa(T value, int drop) {
+    using Traits = bitstream::FloatTraits<T>;
+    using Bits = typename Traits::Bits;
+    Bits bits = Traits::ToBits(value);
+    Bits half = static_cast<Bits>(1) << (drop - 1);
+    Bits mask = ~((static_cast<Bits>(1) << drop) - 1);
+    return Traits::FromBits((bits + half) & mask);
+}
+
+template<typename T>
+T TruncateValue(T value, double max_diff, int max_diff_log2, MantissaTruncation::Bound bound) {
+    using Traits = bitstream::FloatTraits<T>;
+    if (value == 0 || !std::isfinite(value)) return value;
+    // Dropping d bits and rounding errs by at most half the weight of the
+    // lowest kept bit, 2^(e - kMantissaBits + d - 1) for a value in [2^e, 2^(e+1))
+    int drop;
+    double limit;
+    if (bound == MantissaTruncation::kAbsolute) {
+        int exponent = std::max(std::ilogb(value), std::numeric_limits<T>::min_exponent - 1);
+        drop = max_diff_log2 - exponent + Traits::kMantissaBits + 1;
+        limit = max_diff;
+    } else {
+        drop = max_diff_log2 + Traits::kMantissaBits + 1;
+        limit = max_diff * std::fabs(static_cast<double>(value));
+    }
+    drop = std::min(drop, Traits::kMantissaBits);
+    // The estimate of drop is exact for the bound's own power of two; the
+    // check covers the rounding cases next to it (a carry into the exponent,
+    // the largest finite value)
+    for (; drop > 0; --drop) {
+        T rounded = RoundMantissa(value, drop);
+        if (std::isfinite(rounded) && std::fabs(static_cast<double>(rounded) - value) <= limit) return rounded;
+    }
+    return value;
+}
+
+}  // namespace
+
+MantissaTruncation::MantissaTruncation(double max_diff, Bound bound) : max_diff_(max_diff), bound_(bound) {
+    if (!(max_diff > 0) || !std::isfinite(max_diff)) {
+        throw std::runtime_error("[MantissaTruncation Error]: The bound must be positive");
+    }
+    max_diff_log2_ = std::ilogb(max_diff);
+}
+
+double MantissaTruncation::Truncate(double value) const {
+    return TruncateValue(value, max_diff_, max_diff_log2_, bound_);
+}
+
+float MantissaTruncation::Truncate(float value) const {
+    return TruncateValue(value, max_diff_, max_diff_log2_, bound_);
+}
+
+void MantissaTruncation::Forward(const double *src, int count, double *dst) const {
+    for (int i = 0; i < count; ++i) dst[i] = Truncate(src[i]);
+}
+
+void MantissaTruncation::Forward(const float *src, int count, float *dst) const {
+    for (int i = 0; i < count; ++i) dst[i] = Truncate(src[i]);
+}
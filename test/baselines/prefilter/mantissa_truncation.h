@@ -0,0 +1,54 @@
+#ifndef MANTISSA_TRUNCATION_H
+#define MANTISSA_TRUNCATION_H
+
+// Bounded-error stage in front of the lossless XOR codecs (Gorilla, Chimp,
+// Elf). Every value is rounded to the fewest mantissa bits that keep it within
+// the bound, so that its low bits are zero: the XOR with the previous value
+// then has long trailing zero runs, which those codecs store for free.
+//
+// Unlike Prefilter this stage is not reversible. The codec stores the rounded
+// values, and decoding them gives x' with
+//
+//   kAbsolute: |x - x'| <= max_diff
+//   kRelative: |x - x'| <= max_diff * |x|
+//
+// NaN, infinities and zeros pass unchanged. A value keeps its exponent unless
+// rounding carries into it, so a value below the absolute bound is not turned
+// into zero.
+class MantissaTruncation {
+public:
+    enum Bound {
+        kAbsolute,
+        kRelative,
+    };
+
+    // max_diff must be positive
+    explicit MantissaTruncation(double max_diff, Bound bound = kAbsolute);
+
+    // Rounds count values from src into dst; src and dst may be the same
+    void Forward(const double *src, int count, double *dst) const;
+
+    void Forward(const float *src, int count, float *dst) const;
+
+    double Truncate(double value) const;
+
+    float Truncate(float value) const;
+
+    double max_diff() const {
+        return max_diff_;
+    }
+
+    Bound bound() const {
+        return bound_;
+    }
+
+private:
+    double max_diff_;
+
+    Bound bound_;
+
+    // floor(log2(max_diff))
+    int max_diff_log2_;
+};
+
+#endif // MANTISSA_TRUNCATION_H
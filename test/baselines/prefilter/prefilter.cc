@@ -0,0 +1,482 @@
+#include "prefilter.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PREFILTER_X86 1
+#endif
+
+namespace {
+
+#ifdef PREFILTER_X86
+bool HasAvx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+// One step of the unpack network. Viewing the position of a byte as
+// (register index : byte index in register), one step rotates that address
+// left by one bit. For T = 2^t registers of 16 bytes, 4 steps turn 16 values
+// of T bytes into T planes of 16 bytes, and t steps undo it.
+template<int T>
+inline void UnpackStepSse2(const __m128i *in, __m128i *out) {
+    for (int r = 0; r < T / 2; ++r) {
+        out[2 * r] = _mm_unpacklo_epi8(in[r], in[r + T / 2]);
+        out[2 * r + 1] = _mm_unpackhi_epi8(in[r], in[r + T / 2]);
+    }
+}
+
+template<int T>
+inline void UnpackRoundsSse2(__m128i *a, int rounds) {
+    __m128i b[T];
+    for (int round = 0; round < rounds; round += 2) {
+        UnpackStepSse2<T>(a, b);
+        if (round + 1 == rounds) {
+            for (int k = 0; k < T; ++k) a[k] = b[k];
+            return;
+        }
+        UnpackStepSse2<T>(b, a);
+    }
+}
+
+constexpr int Log2(int v) {
+    return v <= 1 ? 0 : 1 + Log2(v / 2);
+}
+
+template<int T>
+int ByteShuffleSse2(const uint8_t *src, uint8_t *dst, int count) {
+    __m128i a[T];
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const uint8_t *in = src + i * T;
+        for (int k = 0; k < T; ++k) a[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16 * k));
+        UnpackRoundsSse2<T>(a, 4);
+        for (int k = 0; k < T; ++k) _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + k * count + i), a[k]);
+    }
+    return i;
+}
+
+template<int T>
+int ByteUnshuffleSse2(const uint8_t *src, uint8_t *dst, int count) {
+    __m128i a[T];
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        for (int k = 0; k < T; ++k) a[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + k * count + i));
+        UnpackRoundsSse2<T>(a, Log2(T));
+        uint8_t *out = dst + i * T;
+        for (int k = 0; k < T; ++k) _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16 * k), a[k]);
+    }
+    return i;
+}
+
+// The AVX2 unpacks work per 128-bit lane, so each lane runs the SSE2 network
+// on its own group of 16 values and the two groups meet again in the planes.
+template<int T>
+__attribute__((target("avx2"))) inline void UnpackRoundsAvx2(__m256i *a, int rounds) {
+    __m256i b[T];
+    for (int round = 0; round < rounds; ++round) {
+        for (int r = 0; r < T / 2; ++r) {
+            b[2 * r] = _mm256_unpacklo_epi8(a[r], a[r + T / 2]);
+            b[2 * r + 1] = _mm256_unpackhi_epi8(a[r], a[r + T / 2]);
+        }
+        for (int k = 0; k < T; ++k) a[k] = b[k];
+    }
+}
+
+template<int T>
+__attribute__((target("avx2"))) int ByteShuffleAvx2(const uint8_t *src, uint8_t *dst, int count) {
+    __m256i a[T];
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const uint8_t *in = src + i * T;
+        for (int k = 0; k < T; ++k) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16 * k));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + 16 * T + 16 * k));
+            a[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        }
+        UnpackRoundsAvx2<T>(a, 4);
+        for (int k = 0; k < T; ++k) _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + k * count + i), a[k]);
+    }
+    return i;
+}
+
+template<int T>
+__attribute__((target("avx2"))) int ByteUnshuffleAvx2(const uint8_t *src, uint8_t *dst, int count) {
+    __m256i a[T];
+    int i = 0;
+    for (; i + 32 <= count; i += 32) {
+        for (int k = 0; k < T; ++k) {
+            a[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + k * count + i));
+        }
+        UnpackRoundsAvx2<T>(a, Log2(T));
+        uint8_t *out = dst + i * T;
+        for (int k = 0; k < T; ++k) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16 * k), _mm256_castsi256_si128(a[k]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16 * T + 16 * k), _mm256_extracti128_si256(a[k], 1));
+        }
+    }
+    return i;
+}
+
+// Bit k of 16 consecutive bytes is collected with one movemask per bit.
+int BitTransposeSse2(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    int i = 0;
+    for (; i + 16 <= n8; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        for (int k = 7; k >= 0; --k) {
+            auto bits = static_cast<uint16_t>(_mm_movemask_epi8(x));
+            std::memcpy(dst + k * plane_size + i / 8, &bits, sizeof(bits));
+            x = _mm_add_epi8(x, x);
+        }
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) int BitTransposeAvx2(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    int i = 0;
+    for (; i + 32 <= n8; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        for (int k = 7; k >= 0; --k) {
+            auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(x));
+            std::memcpy(dst + k * plane_size + i / 8, &bits, sizeof(bits));
+            x = _mm256_add_epi8(x, x);
+        }
+    }
+    return i;
+}
+
+// The inverse of the movemask: every bit of a plane is spread to its byte,
+// turned into a full byte by comparing against its selector, and the bit of
+// that plane is kept.
+int BitUntransposeSse2(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    const __m128i select = _mm_set1_epi64x(0x8040201008040201LL);
+    int i = 0;
+    for (; i + 16 <= n8; i += 16) {
+        __m128i x = _mm_setzero_si128();
+        for (int k = 0; k < 8; ++k) {
+            uint16_t bits;
+            std::memcpy(&bits, src + k * plane_size + i / 8, sizeof(bits));
+            __m128i spread = _mm_set_epi64x(static_cast<int64_t>((bits >> 8) * 0x0101010101010101ULL),
+                                            static_cast<int64_t>((bits & 0xFF) * 0x0101010101010101ULL));
+            __m128i set = _mm_cmpeq_epi8(_mm_and_si128(spread, select), select);
+            x = _mm_or_si128(x, _mm_and_si128(set, _mm_set1_epi8(static_cast<char>(1 << k))));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), x);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) int BitUntransposeAvx2(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    const __m256i select = _mm256_set1_epi64x(0x8040201008040201LL);
+    // Byte j of the 32 bits goes to bytes 8j..8j+7; the shuffle is per lane
+    // and both lanes hold the broadcast word.
+    const __m256i spread_index = _mm256_set_epi64x(0x0303030303030303LL, 0x0202020202020202LL,
+                                                   0x0101010101010101LL, 0);
+    int i = 0;
+    for (; i + 32 <= n8; i += 32) {
+        __m256i x = _mm256_setzero_si256();
+        for (int k = 0; k < 8; ++k) {
+            uint32_t bits;
+            std::memcpy(&bits, src + k * plane_size + i / 8, sizeof(bits));
+            __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)), spread_index);
+            __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(spread, select), select);
+            x = _mm256_or_si256(x, _mm256_and_si256(set, _mm256_set1_epi8(static_cast<char>(1 << k))));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), x);
+    }
+    return i;
+}
+#endif
+
+template<int T>
+int ByteShuffleSimd(const uint8_t *src, uint8_t *dst, int count) {
+#ifdef PREFILTER_X86
+    if (HasAvx2()) return ByteShuffleAvx2<T>(src, dst, count);
+    return ByteShuffleSse2<T>(src, dst, count);
+#else
+    return 0;
+#endif
+}
+
+template<int T>
+int ByteUnshuffleSimd(const uint8_t *src, uint8_t *dst, int count) {
+#ifdef PREFILTER_X86
+    if (HasAvx2()) return ByteUnshuffleAvx2<T>(src, dst, count);
+    return ByteUnshuffleSse2<T>(src, dst, count);
+#else
+    return 0;
+#endif
+}
+
+// 8x8 bit matrix transpose (Hacker's Delight 7-3). Byte i of x is row i, so
+// the result has bit i of byte k equal to bit k of input byte i. It is its
+// own inverse.
+inline uint64_t Transpose8x8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+// Splits n8 (a multiple of 8) bytes into 8 bit planes of n8 / 8 bytes.
+void BitTranspose(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    int i = 0;
+#ifdef PREFILTER_X86
+    i = HasAvx2() ? BitTransposeAvx2(src, dst, n8) : BitTransposeSse2(src, dst, n8);
+#endif
+    for (; i < n8; i += 8) {
+        uint64_t x;
+        std::memcpy(&x, src + i, sizeof(x));
+        x = Transpose8x8(x);
+        for (int k = 0; k < 8; ++k) dst[k * plane_size + i / 8] = static_cast<uint8_t>(x >> (8 * k));
+    }
+}
+
+void BitUntranspose(const uint8_t *src, uint8_t *dst, int n8) {
+    int plane_size = n8 / 8;
+    int i = 0;
+#ifdef PREFILTER_X86
+    i = HasAvx2() ? BitUntransposeAvx2(src, dst, n8) : BitUntransposeSse2(src, dst, n8);
+#endif
+    for (; i < n8; i += 8) {
+        uint64_t x = 0;
+        for (int k = 0; k < 8; ++k) x |= static_cast<uint64_t>(src[k * plane_size + i / 8]) << (8 * k);
+        x = Transpose8x8(x);
+        std::memcpy(dst + i, &x, sizeof(x));
+    }
+}
+
+template<typename U>
+inline U ZigZag(U delta) {
+    using S = typename std::make_signed<U>::type;
+    return (delta << 1) ^ static_cast<U>(static_cast<S>(delta) >> (sizeof(U) * 8 - 1));
+}
+
+template<typename U>
+inline U UnZigZag(U code) {
+    return (code >> 1) ^ (U(0) - (code & 1));
+}
+
+template<typename U>
+void XorPreviousImpl(const U *__restrict__ src, U *__restrict__ dst, int count) {
+    if (count <= 0) return;
+    dst[0] = src[0];
+    for (int i = 1; i < count; ++i) dst[i] = src[i] ^ src[i - 1];
+}
+
+template<typename U>
+void XorPreviousInverseImpl(const U *__restrict__ src, U *__restrict__ dst, int count) {
+    U prev = 0;
+    for (int i = 0; i < count; ++i) {
+        prev ^= src[i];
+        dst[i] = prev;
+    }
+}
+
+template<typename U>
+void DeltaBitsImpl(const U *__restrict__ src, U *__restrict__ dst, int count) {
+    if (count <= 0) return;
+    dst[0] = ZigZag<U>(src[0]);
+    for (int i = 1; i < count; ++i) dst[i] = ZigZag<U>(src[i] - src[i - 1]);
+}
+
+template<typename U>
+void DeltaBitsInverseImpl(const U *__restrict__ src, U *__restrict__ dst, int count) {
+    U prev = 0;
+    for (int i = 0; i < count; ++i) {
+        prev += UnZigZag<U>(src[i]);
+        dst[i] = prev;
+    }
+}
+
+}  // namespace
+
+Prefilter::Prefilter(uint32_t stages, int type_size) : stages_(stages), type_size_(type_size) {
+    if (type_size_ <= 0) {
+        throw std::invalid_argument("[Prefilter Error]: Invalid type size.");
+    }
+    if ((stages_ & kXorPrevious) && (stages_ & kDeltaBits)) {
+        throw std::invalid_argument("[Prefilter Error]: XOR and delta stages are exclusive.");
+    }
+    if ((stages_ & kByteShuffle) && (stages_ & kBitShuffle)) {
+        throw std::invalid_argument("[Prefilter Error]: Byte and bit shuffle stages are exclusive.");
+    }
+    if ((stages_ & (kXorPrevious | kDeltaBits)) && type_size_ != 4 && type_size_ != 8) {
+        throw std::invalid_argument("[Prefilter Error]: Value stages need 4 or 8 byte values.");
+    }
+}
+
+void Prefilter::Forward(const void *src, int count, uint8_t *dst) {
+    size_t bytes = static_cast<size_t>(count) * type_size_;
+    bool value_stage = stages_ & (kXorPrevious | kDeltaBits);
+    bool shuffle_stage = stages_ & (kByteShuffle | kBitShuffle);
+    if (!value_stage && !shuffle_stage) {
+        std::memcpy(dst, src, bytes);
+        return;
+    }
+    if (scratch_.size() < bytes) scratch_.resize(bytes);
+
+    auto cur = static_cast<const uint8_t *>(src);
+    if (value_stage) {
+        if (!shuffle_stage) {
+            ValueForward(src, count, dst);
+            return;
+        }
+        ValueForward(src, count, scratch_.data());
+        cur = scratch_.data();
+    }
+    if (stages_ & kBitShuffle) {
+        BitShuffle(cur, dst, count, type_size_);
+    } else {
+        ByteShuffle(cur, dst, count, type_size_);
+    }
+}
+
+void Prefilter::Inverse(const uint8_t *src, int count, void *dst) {
+    size_t bytes = static_cast<size_t>(count) * type_size_;
+    bool value_stage = stages_ & (kXorPrevious | kDeltaBits);
+    bool shuffle_stage = stages_ & (kByteShuffle | kBitShuffle);
+    if (!value_stage && !shuffle_stage) {
+        std::memcpy(dst, src, bytes);
+        return;
+    }
+    if (scratch_.size() < bytes) scratch_.resize(bytes);
+
+    const uint8_t *cur = src;
+    if (shuffle_stage) {
+        uint8_t *out = value_stage ? scratch_.data() : static_cast<uint8_t *>(dst);
+        if (stages_ & kBitShuffle) {
+            BitUnshuffle(src, out, count, type_size_);
+        } else {
+            ByteUnshuffle(src, out, count, type_size_);
+        }
+        cur = out;
+    }
+    if (value_stage) ValueInverse(cur, count, dst);
+}
+
+void Prefilter::ValueForward(const void *src, int count, void *dst) {
+    if (type_size_ == 8) {
+        auto in = static_cast<const uint64_t *>(src);
+        auto out = static_cast<uint64_t *>(dst);
+        if (stages_ & kXorPrevious) XorPrevious(in, out, count); else DeltaBits(in, out, count);
+    } else {
+        auto in = static_cast<const uint32_t *>(src);
+        auto out = static_cast<uint32_t *>(dst);
+        if (stages_ & kXorPrevious) XorPrevious(in, out, count); else DeltaBits(in, out, count);
+    }
+}
+
+void Prefilter::ValueInverse(const void *src, int count, void *dst) {
+    if (type_size_ == 8) {
+        auto in = static_cast<const uint64_t *>(src);
+        auto out = static_cast<uint64_t *>(dst);
+        if (stages_ & kXorPrevious) XorPreviousInverse(in, out, count); else DeltaBitsInverse(in, out, count);
+    } else {
+        auto in = static_cast<const uint32_t *>(src);
+        auto out = static_cast<uint32_t *>(dst);
+        if (stages_ & kXorPrevious) XorPreviousInverse(in, out, count); else DeltaBitsInverse(in, out, count);
+    }
+}
+
+void Prefilter::ByteShuffle(const uint8_t *src, uint8_t *dst, int count, int type_size) {
+    int i = 0;
+    switch (type_size) {
+        case 2: i = ByteShuffleSimd<2>(src, dst, count); break;
+        case 4: i = ByteShuffleSimd<4>(src, dst, count); break;
+        case 8: i = ByteShuffleSimd<8>(src, dst, count); break;
+        default: break;
+    }
+    for (; i < count; ++i) {
+        for (int k = 0; k < type_size; ++k) dst[k * count + i] = src[i * type_size + k];
+    }
+}
+
+void Prefilter::ByteUnshuffle(const uint8_t *src, uint8_t *dst, int count, int type_size) {
+    int i = 0;
+    switch (type_size) {
+        case 2: i = ByteUnshuffleSimd<2>(src, dst, count); break;
+        case 4: i = ByteUnshuffleSimd<4>(src, dst, count); break;
+        case 8: i = ByteUnshuffleSimd<8>(src, dst, count); break;
+        default: break;
+    }
+    for (; i < count; ++i) {
+        for (int k = 0; k < type_size; ++k) dst[i * type_size + k] = src[k * count + i];
+    }
+}
+
+void Prefilter::BitShuffle(const uint8_t *src, uint8_t *dst, int count, int type_size) {
+    // Byte planes are built in a thread local buffer and then split into bit
+    // planes, so dst may not alias src.
+    static thread_local std::vector<uint8_t> planes;
+    size_t bytes = static_cast<size_t>(count) * type_size;
+    if (planes.size() < bytes) planes.resize(bytes);
+    ByteShuffle(src, planes.data(), count, type_size);
+
+    int n8 = count & ~7;
+    for (int k = 0; k < type_size; ++k) {
+        const uint8_t *plane = planes.data() + static_cast<size_t>(k) * count;
+        uint8_t *out = dst + static_cast<size_t>(k) * count;
+        BitTranspose(plane, out, n8);
+        std::memcpy(out + n8, plane + n8, count - n8);
+    }
+}
+
+void Prefilter::BitUnshuffle(const uint8_t *src, uint8_t *dst, int count, int type_size) {
+    static thread_local std::vector<uint8_t> planes;
+    size_t bytes = static_cast<size_t>(count) * type_size;
+    if (planes.size() < bytes) planes.resize(bytes);
+
+    int n8 = count & ~7;
+    for (int k = 0; k < type_size; ++k) {
+        const uint8_t *in = src + static_cast<size_t>(k) * count;
+        uint8_t *plane = planes.data() + static_cast<size_t>(k) * count;
+        BitUntranspose(in, plane, n8);
+        std::memcpy(plane + n8, in + n8, count - n8);
+    }
+    ByteUnshuffle(planes.data(), dst, count, type_size);
+}
+
+void Prefilter::XorPrevious(const uint64_t *src, uint64_t *dst, int count) {
+    XorPreviousImpl(src, dst, count);
+}
+
+void Prefilter::XorPreviousInverse(const uint64_t *src, uint64_t *dst, int count) {
+    XorPreviousInverseImpl(src, dst, count);
+}
+
+void Prefilter::XorPrevious(const uint32_t *src, uint32_t *dst, int count) {
+    XorPreviousImpl(src, dst, count);
+}
+
+void Prefilter::XorPreviousInverse(const uint32_t *src, uint32_t *dst, int count) {
+    XorPreviousInverseImpl(src, dst, count);
+}
+
+void Prefilter::DeltaBits(const uint64_t *src, uint64_t *dst, int count) {
+    DeltaBitsImpl(src, dst, count);
+}
+
+void Prefilter::DeltaBitsInverse(const uint64_t *src, uint64_t *dst, int count) {
+    DeltaBitsInverseImpl(src, dst, count);
+}
+
+void Prefilter::DeltaBits(const uint32_t *src, uint32_t *dst, int count) {
+    DeltaBitsImpl(src, dst, count);
+}
+
+void Prefilter::DeltaBitsInverse(const uint32_t *src, uint32_t *dst, int count) {
+    DeltaBitsInverseImpl(src, dst, count);
+}
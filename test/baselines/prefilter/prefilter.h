@@ -0,0 +1,87 @@
+#ifndef PREFILTER_H
+#define PREFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reversible transforms that reorder the bytes of a block of floating point
+// values before it is handed to a general purpose byte codec (Deflate, LZ4,
+// Snappy, FastLZ, Zstd). The output always has exactly count * type_size
+// bytes, so any byte codec can be put behind it unchanged.
+//
+// The value stage (XOR / delta) runs first, then the byte or bit transpose.
+// The inverse runs the stages in reverse order.
+class Prefilter {
+public:
+    enum Stage : uint32_t {
+        kNone = 0,
+        // v[i] ^ v[i - 1] on the raw bit patterns
+        kXorPrevious = 1u << 0,
+        // zigzag(v[i] - v[i - 1]) on the raw bit patterns
+        kDeltaBits = 1u << 1,
+        // byte k of every value goes to plane k
+        kByteShuffle = 1u << 2,
+        // bit k of every value goes to plane k (implies the byte transpose)
+        kBitShuffle = 1u << 3,
+    };
+
+    // type_size is the width of one value in bytes; the value stages support
+    // 4 (float) and 8 (double).
+    Prefilter(uint32_t stages, int type_size);
+
+    // Transforms count values at src into count * type_size bytes at dst.
+    void Forward(const void *src, int count, uint8_t *dst);
+
+    // Restores count values into dst from the output of Forward.
+    void Inverse(const uint8_t *src, int count, void *dst);
+
+    uint32_t stages() const {
+        return stages_;
+    }
+
+    int type_size() const {
+        return type_size_;
+    }
+
+    // Byte-plane transpose: dst[k * count + i] = src[i * type_size + k].
+    static void ByteShuffle(const uint8_t *src, uint8_t *dst, int count, int type_size);
+
+    static void ByteUnshuffle(const uint8_t *src, uint8_t *dst, int count, int type_size);
+
+    // Bit-plane transpose. Every byte plane of ByteShuffle is split into 8 bit
+    // planes of count / 8 bytes each; the count % 8 tail bytes of a plane are
+    // kept as they are after its bit planes.
+    static void BitShuffle(const uint8_t *src, uint8_t *dst, int count, int type_size);
+
+    static void BitUnshuffle(const uint8_t *src, uint8_t *dst, int count, int type_size);
+
+    static void XorPrevious(const uint64_t *src, uint64_t *dst, int count);
+
+    static void XorPreviousInverse(const uint64_t *src, uint64_t *dst, int count);
+
+    static void XorPrevious(const uint32_t *src, uint32_t *dst, int count);
+
+    static void XorPreviousInverse(const uint32_t *src, uint32_t *dst, int count);
+
+    static void DeltaBits(const uint64_t *src, uint64_t *dst, int count);
+
+    static void DeltaBitsInverse(const uint64_t *src, uint64_t *dst, int count);
+
+    static void DeltaBits(const uint32_t *src, uint32_t *dst, int count);
+
+    static void DeltaBitsInverse(const uint32_t *src, uint32_t *dst, int count);
+
+private:
+    uint32_t stages_;
+
+    int type_size_;
+
+    std::vector<uint8_t> scratch_;
+
+    void ValueForward(const void *src, int count, void *dst);
+
+    void ValueInverse(const void *src, int count, void *dst);
+};
+
+#endif // PREFILTER_H
@@ -0,0 +1,130 @@
+#include "quality_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define QUALITY_X86 1
+#endif
+
+namespace {
+
+template<typename T>
+void MeasureScalar(const T *original, const T *decoded, size_t begin, size_t count, double max_diff,
+                   QualityMetrics &metrics) {
+    for (size_t i = begin; i < count; ++i) {
+        double o = original[i];
+        double d = decoded[i];
+        double error = o == d || (std::isnan(o) && std::isnan(d)) ? 0 : std::fabs(o - d);
+        if (!(error <= max_diff)) ++metrics.bound_violations;
+        if (!std::isnan(error)) {
+            metrics.max_abs_error = std::max(metrics.max_abs_error, error);
+            metrics.sum_squared_error += error * error;
+        }
+        // NaN compares false and leaves the range alone
+        if (o < metrics.min_value) metrics.min_value = o;
+        if (o > metrics.max_value) metrics.max_value = o;
+    }
+}
+
+#ifdef QUALITY_X86
+bool HasAvx2() {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+__attribute__((target("avx2"))) inline __m256d Load4(const double *values) {
+    return _mm256_loadu_pd(values);
+}
+
+__attribute__((target("avx2"))) inline __m256d Load4(const float *values) {
+    return _mm256_cvtps_pd(_mm_loadu_ps(values));
+}
+
+// The whole vectors of four values; returns how many values it measured
+template<typename T>
+__attribute__((target("avx2"))) size_t MeasureAvx2(const T *original, const T *decoded, size_t count,
+                                                   double max_diff, QualityMetrics &metrics) {
+    const __m256d bound = _mm256_set1_pd(max_diff);
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256i violations = _mm256_setzero_si256();
+    __m256d max_error = _mm256_setzero_pd();
+    __m256d sum_squared_error = _mm256_setzero_pd();
+    __m256d min_value = _mm256_set1_pd(metrics.min_value);
+    __m256d max_value = _mm256_set1_pd(metrics.max_value);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d o = Load4(original + i);
+        __m256d d = Load4(decoded + i);
+        __m256d same = _mm256_or_pd(_mm256_cmp_pd(o, d, _CMP_EQ_OQ),
+                                    _mm256_and_pd(_mm256_cmp_pd(o, o, _CMP_UNORD_Q), _mm256_cmp_pd(d, d, _CMP_UNORD_Q)));
+        __m256d error = _mm256_andnot_pd(same, _mm256_and_pd(abs_mask, _mm256_sub_pd(o, d)));
+        // A set lane is -1
+        violations = _mm256_sub_epi64(violations, _mm256_castpd_si256(_mm256_cmp_pd(error, bound, _CMP_NLE_UQ)));
+        // With a NaN in the first operand, max and min return the second
+        max_error = _mm256_max_pd(error, max_error);
+        __m256d ordered = _mm256_and_pd(error, _mm256_cmp_pd(error, error, _CMP_ORD_Q));
+        sum_squared_error = _mm256_add_pd(sum_squared_error, _mm256_mul_pd(ordered, ordered));
+        min_value = _mm256_min_pd(o, min_value);
+        max_value = _mm256_max_pd(o, max_value);
+    }
+
+    alignas(32) int64_t violation_lanes[4];
+    alignas(32) double lanes[4][4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(violation_lanes), violations);
+    _mm256_store_pd(lanes[0], max_error);
+    _mm256_store_pd(lanes[1], sum_squared_error);
+    _mm256_store_pd(lanes[2], min_value);
+    _mm256_store_pd(lanes[3], max_value);
+    for (int k = 0; k < 4; ++k) {
+        metrics.bound_violations += violation_lanes[k];
+        metrics.max_abs_error = std::max(metrics.max_abs_error, lanes[0][k]);
+        metrics.sum_squared_error += lanes[1][k];
+        metrics.min_value = std::min(metrics.min_value, lanes[2][k]);
+        metrics.max_value = std::max(metrics.max_value, lanes[3][k]);
+    }
+    return i;
+}
+#endif
+
+template<typename T>
+QualityMetrics Measure(const T *original, const T *decoded, size_t count, double max_diff) {
+    QualityMetrics metrics;
+    metrics.count = count;
+    size_t i = 0;
+#ifdef QUALITY_X86
+    if (HasAvx2()) i = MeasureAvx2(original, decoded, count, max_diff, metrics);
+#endif
+    MeasureScalar(original, decoded, i, count, max_diff, metrics);
+    return metrics;
+}
+
+}  // namespace
+
+void QualityMetrics::Merge(const QualityMetrics &other) {
+    count += other.count;
+    bound_violations += other.bound_violations;
+    max_abs_error = std::max(max_abs_error, other.max_abs_error);
+    sum_squared_error += other.sum_squared_error;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+}
+
+double QualityMetrics::Rmse() const {
+    return count == 0 ? 0 : std::sqrt(sum_squared_error / static_cast<double>(count));
+}
+
+double QualityMetrics::Psnr() const {
+    double rmse = Rmse();
+    if (rmse == 0) return std::numeric_limits<double>::infinity();
+    return 20 * std::log10((max_value - min_value) / rmse);
+}
+
+QualityMetrics MeasureQuality(const double *original, const double *decoded, size_t count, double max_diff) {
+    return Measure(original, decoded, count, max_diff);
+}
+
+QualityMetrics MeasureQuality(const float *original, const float *decoded, size_t count, double max_diff) {
+    return Measure(original, decoded, count, max_diff);
+}
@@ -0,0 +1,45 @@
+#ifndef QUALITY_METRICS_H
+#define QUALITY_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// How far a decompressed block is from the original, for the lossy codecs and
+// as the round-trip check of the lossless ones (max_diff 0). One pass over the
+// block, run outside the timed region. Blocks are merged into the metrics of a
+// whole data set.
+//
+// A value decoded equal, or a NaN decoded as a NaN, has no error. Any other
+// NaN error counts as a bound violation, but is left out of the max error and
+// the RMSE.
+struct QualityMetrics {
+    uint64_t count = 0;
+
+    // Values with |original - decoded| > max_diff
+    uint64_t bound_violations = 0;
+
+    double max_abs_error = 0;
+
+    double sum_squared_error = 0;
+
+    // Range of the original values, for the PSNR
+    double min_value = std::numeric_limits<double>::infinity();
+
+    double max_value = -std::numeric_limits<double>::infinity();
+
+    void Merge(const QualityMetrics &other);
+
+    double Rmse() const;
+
+    // 20 log10((max_value - min_value) / RMSE) in dB, infinite for an exact
+    // reconstruction
+    double Psnr() const;
+};
+
+QualityMetrics MeasureQuality(const double *original, const double *decoded, size_t count, double max_diff);
+
+// The errors of float values are taken in double
+QualityMetrics MeasureQuality(const float *original, const float *decoded, size_t count, double max_diff);
+
+#endif // QUALITY_METRICS_H
@@ -1,40 +1,181 @@
 #include "sim_piece.h"
 
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIM_PIECE_X86 1
+#endif
+
+namespace {
+
+// The serialized slope is a float: one in [a_min, a_max], next to its middle, or NaN when the interval holds none
+double slopeAsFloat(double a_min, double a_max) {
+  float a = static_cast<float>(a_min / 2 + a_max / 2);
+  if (a > a_max) a = std::nextafter(a, -std::numeric_limits<float>::infinity());
+  else if (a < a_min) a = std::nextafter(a, std::numeric_limits<float>::infinity());
+  return a >= a_min && a <= a_max ? a : std::numeric_limits<double>::quiet_NaN();
+}
+
+bool lessByBA(const SimPieceSegment &s1, const SimPieceSegment &s2) {
+  if (s1.getB() == s2.getB())
+    return s1.getA() < s2.getA();
+  return s1.getB() < s2.getB();
+}
+
+// Runs job(0), ..., job(count - 1), one per thread
+template<typename Job>
+void runParallel(int count, Job job) {
+  std::vector<std::thread> threads;
+  threads.reserve(count);
+  for (int i = 0; i < count; ++i) threads.emplace_back(job, i);
+  for (auto &thread : threads) thread.join();
+}
+
+// The timestamp offset after begin where the next segment starts
+inline size_t segmentEnd(const uint64_t *starts, size_t begin) {
+  size_t word = (begin + 1) >> 6;
+  uint64_t bits = starts[word] & (~0ULL << ((begin + 1) & 63));
+  while (bits == 0) bits = starts[++word];
+  return (word << 6) + __builtin_ctzll(bits);
+}
+
+// Evaluates each segment, a * (t - t0) + b, from its start t0 to the next start
+void evaluateSegments(const std::vector<SimPieceSegment> &segments, const uint64_t *starts, long first_timestamp,
+                      double *values) {
+  for (const auto &segment : segments) {
+    size_t begin = segment.getInitTimestamp() - first_timestamp;
+    size_t count = segmentEnd(starts, begin) - begin;
+    double a = segment.getA(), b = segment.getB();
+    // Fused, as the vector kernel, so that the output does not depend on the CPU
+    for (size_t i = 0; i < count; ++i) values[begin + i] = std::fma(a, static_cast<double>(i), b);
+  }
+}
+
+bool simd_enabled = true;
+
+#ifdef SIM_PIECE_X86
+bool hasAvx2Fma() {
+  static const bool has_avx2_fma = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return has_avx2_fma;
+}
+
+__attribute__((target("avx2,fma"))) void evaluateSegmentsAvx2(const std::vector<SimPieceSegment> &segments,
+                                                              const uint64_t *starts, long first_timestamp,
+                                                              double *values) {
+  const __m256d x0 = _mm256_setr_pd(0, 1, 2, 3);
+  const __m256d step = _mm256_set1_pd(4);
+  for (const auto &segment : segments) {
+    size_t begin = segment.getInitTimestamp() - first_timestamp;
+    size_t count = segmentEnd(starts, begin) - begin;
+    double *out = values + begin;
+    const __m256d va = _mm256_set1_pd(segment.getA());
+    const __m256d vb = _mm256_set1_pd(segment.getB());
+    __m256d x = x0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      _mm256_storeu_pd(out + i, _mm256_fmadd_pd(va, x, vb));
+      x = _mm256_add_pd(x, step);
+    }
+    if (i < count) {
+      // The tail lanes, masked so that the next segment's values are left alone
+      const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+      __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(count - i)), lanes);
+      _mm256_maskstore_pd(out + i, mask, _mm256_fmadd_pd(va, x, vb));
+    }
+  }
+}
+#endif
+
+}  // namespace
+
 SimPiece::SimPiece(std::vector<Point> points, double epsilon) {
   epsilon_ = epsilon;
   last_timestamp_ = points[points.size() - 1].getTimestamp();
   segments_ = mergePerB(compress(points));
 }
 
+SimPiece::SimPiece(const std::vector<float> &values, double epsilon) {
+  std::vector<Point> points = toPoints(values);
+  epsilon_ = epsilon;
+  relative_margin_ = std::numeric_limits<float>::epsilon();
+  last_timestamp_ = points[points.size() - 1].getTimestamp();
+  segments_ = mergePerB(compress(points));
+}
+
+SimPiece::SimPiece(const std::vector<Point> &points, double epsilon, int thread_count) {
+  epsilon_ = epsilon;
+  last_timestamp_ = points[points.size() - 1].getTimestamp();
+  int chunk_count = std::max(1, std::min(thread_count, static_cast<int>(points.size() / kMinChunkPoints)));
+  segments_ = mergePerBParallel(compressParallel(points, chunk_count), chunk_count);
+}
+
 SimPiece::SimPiece(char *input, int len, bool variableByte) {
   readByteArray(input, len, variableByte);
 }
 
 std::vector<Point> SimPiece::decompress() {
+  std::vector<double> values(decompressedCount());
+  std::vector<long> timestamps(values.size());
+  decompress(values.data(), timestamps.data());
+
   std::vector<Point> points;
+  points.reserve(values.size());
+  for (size_t i = 0; i < values.size(); ++i) points.emplace_back(timestamps[i], values[i]);
+  return points;
+}
 
-  std::sort(segments_.begin(), segments_.end(), [](SimPieceSegment& s1, SimPieceSegment& s2) {
-    return s1.getInitTimestamp() < s2.getInitTimestamp();
-  });
+void SimPiece::setSimdEnabled(bool enabled) {
+  simd_enabled = enabled;
+}
 
-  long currentTimeStamp = segments_[0].getInitTimestamp();
+size_t SimPiece::decompressedCount() const {
+  if (segments_.empty()) return 0;
+  long first_timestamp = segments_[0].getInitTimestamp();
+  for (const auto &segment : segments_) first_timestamp = std::min(first_timestamp, segment.getInitTimestamp());
+  return static_cast<size_t>(last_timestamp_ - first_timestamp + 1);
+}
 
-  for (size_t i = 0; i < segments_.size() - 1; ++i) {
-    while (currentTimeStamp < segments_[i + 1].getInitTimestamp()) {
-      points.emplace_back(currentTimeStamp,
-                          segments_[i].getA() * (currentTimeStamp - segments_[i].getInitTimestamp()) + segments_[i]
-                          .getB());
-      currentTimeStamp++;
-    }
+size_t SimPiece::decompress(double *values, long *timestamps) const {
+  size_t count = decompressedCount();
+  if (count == 0) return 0;
+  long first_timestamp = last_timestamp_ + 1 - static_cast<long>(count);
+
+  // The segments are stored by (b, a): a bitmap of their starts, with one past the end, gives each one its end
+  // without sorting them
+  std::vector<uint64_t> starts(count / 64 + 1);
+  for (const auto &segment : segments_) {
+    size_t offset = segment.getInitTimestamp() - first_timestamp;
+    starts[offset >> 6] |= 1ULL << (offset & 63);
   }
+  starts[count >> 6] |= 1ULL << (count & 63);
+
+#ifdef SIM_PIECE_X86
+  if (simd_enabled && hasAvx2Fma()) evaluateSegmentsAvx2(segments_, starts.data(), first_timestamp, values);
+  else evaluateSegments(segments_, starts.data(), first_timestamp, values);
+#else
+  evaluateSegments(segments_, starts.data(), first_timestamp, values);
+#endif
 
-  while (currentTimeStamp <= last_timestamp_) {
-    points.emplace_back(currentTimeStamp,
-                        segments_.back().getA() * (currentTimeStamp - segments_.back().getInitTimestamp()) + segments_
-                        .back().getB());
-    currentTimeStamp++;
+  if (timestamps != nullptr) {
+    for (size_t i = 0; i < count; ++i) timestamps[i] = first_timestamp + static_cast<long>(i);
   }
+  return count;
+}
 
+// The segments are fitted in double; only the reconstruction is rounded
+std::vector<float> SimPiece::decompress32() {
+  std::vector<double> points(decompressedCount());
+  decompress(points.data());
+  return std::vector<float>(points.begin(), points.end());
+}
+
+std::vector<Point> SimPiece::toPoints(const std::vector<float> &values) {
+  std::vector<Point> points;
+  points.reserve(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    points.emplace_back(static_cast<long>(i), values[i]);
+  }
   return points;
 }
 
@@ -49,32 +190,53 @@ int SimPiece::toByteArray(char *dst, bool variableByte, int *timestamp_store_siz
   return bytes.length();
 }
 
+size_t SimPiece::maxByteArraySize() const {
+  // Variable bytes take up to 5 bytes, a float or a UInt 4. The stream holds epsilon, the number of b values, the
+  // first b and last_timestamp_; a segment adds at most a new b (delta and a count), a new a (value and a count)
+  // and its timestamp.
+  constexpr size_t kFixedBytes = 4 + 5 + 5 + 5;
+  constexpr size_t kSegmentBytes = (5 + 5) + (4 + 5) + 5;
+  return kFixedBytes + segments_.size() * kSegmentBytes;
+}
+
+double SimPiece::tolerance(double value) const {
+  return std::max(0.0, epsilon_ - relative_margin_ * (std::fabs(value) + epsilon_));
+}
+
+// In steps of the serialized epsilon, a float, so that the decoder's b is the same
 double SimPiece::quantization(double value) {
-  return std::round(value / epsilon_) * epsilon_;
+  double step = static_cast<float>(epsilon_);
+  return std::round(value / step) * step;
 }
 
-int SimPiece::createSegment(int start_idx, std::vector<Point> points, std::vector<SimPieceSegment> &segments) {
+int SimPiece::createSegment(int start_idx, int end_idx, const std::vector<Point> &points,
+                            std::vector<SimPieceSegment> &segments) {
   long initTimestamp = points[start_idx].getTimestamp();
   double b = quantization(points[start_idx].getValue());
 
-  if (start_idx + 1 == points.size()) {
+  if (start_idx + 1 == end_idx) {
     segments.emplace_back(initTimestamp, -std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), b);
     return start_idx + 1;
   }
 
-  double aMax = ((points[start_idx + 1].getValue() + epsilon_) - b) / (points[start_idx + 1].getTimestamp() -
-      initTimestamp);
-  double aMin = ((points[start_idx + 1].getValue() - epsilon_) - b) / (points[start_idx + 1].getTimestamp() -
-      initTimestamp);
+  double aMax = ((points[start_idx + 1].getValue() + tolerance(points[start_idx + 1].getValue())) - b) /
+      (points[start_idx + 1].getTimestamp() - initTimestamp);
+  double aMin = ((points[start_idx + 1].getValue() - tolerance(points[start_idx + 1].getValue())) - b) /
+      (points[start_idx + 1].getTimestamp() - initTimestamp);
+
+  if (std::isnan(slopeAsFloat(aMin, aMax))) {
+    segments.emplace_back(initTimestamp, -std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), b);
+    return start_idx + 1;
+  }
 
-  if (start_idx + 2 == points.size()) {
+  if (start_idx + 2 == end_idx) {
     segments.emplace_back(initTimestamp, aMin, aMax, b);
     return start_idx + 2;
   }
 
-  for (size_t idx = start_idx + 2; idx < points.size(); ++idx) {
-    double upValue = points[idx].getValue() + epsilon_;
-    double downValue = points[idx].getValue() - epsilon_;
+  for (int idx = start_idx + 2; idx < end_idx; ++idx) {
+    double upValue = points[idx].getValue() + tolerance(points[idx].getValue());
+    double downValue = points[idx].getValue() - tolerance(points[idx].getValue());
 
     double upLim = aMax * (points[idx].getTimestamp() - initTimestamp) + b;
     double downLim = aMin * (points[idx].getTimestamp() - initTimestamp) + b;
@@ -84,46 +246,105 @@ int SimPiece::createSegment(int start_idx, std::vector<Point> points, std::vecto
       return idx;
     }
 
+    double newAMax = aMax, newAMin = aMin;
     if (upValue < upLim)
-      aMax = std::max((upValue - b) / (points[idx].getTimestamp() - initTimestamp), aMin);
+      newAMax = std::max((upValue - b) / (points[idx].getTimestamp() - initTimestamp), aMin);
     if (downValue > downLim)
-      aMin = std::min((downValue - b) / (points[idx].getTimestamp() - initTimestamp), aMax);
+      newAMin = std::min((downValue - b) / (points[idx].getTimestamp() - initTimestamp), newAMax);
+    // No float slope fits every point up to idx
+    if (std::isnan(slopeAsFloat(newAMin, newAMax))) {
+      segments.emplace_back(initTimestamp, aMin, aMax, b);
+      return idx;
+    }
+    aMax = newAMax;
+    aMin = newAMin;
   }
 
   segments.emplace_back(initTimestamp, aMin, aMax, b);
 
-  return points.size();
+  return end_idx;
 }
 
 std::vector<SimPieceSegment> SimPiece::compress(std::vector<Point> points) {
   std::vector<SimPieceSegment> segments;
   int currentIdx = 0;
   while (currentIdx < points.size())
-    currentIdx = createSegment(currentIdx, points, segments);
+    currentIdx = createSegment(currentIdx, points.size(), points, segments);
+
+  return segments;
+}
+
+std::vector<SimPieceSegment> SimPiece::compressParallel(const std::vector<Point> &points, int chunk_count) {
+  std::vector<std::vector<SimPieceSegment>> chunk_segments(chunk_count);
+  runParallel(chunk_count, [&](int chunk) {
+    int end_idx = static_cast<int>(points.size() * (chunk + 1) / chunk_count);
+    int currentIdx = static_cast<int>(points.size() * chunk / chunk_count);
+    while (currentIdx < end_idx)
+      currentIdx = createSegment(currentIdx, end_idx, points, chunk_segments[chunk]);
+  });
 
+  std::vector<SimPieceSegment> segments;
+  for (auto &chunk : chunk_segments) segments.insert(segments.end(), chunk.begin(), chunk.end());
   return segments;
 }
 
 std::vector<SimPieceSegment> SimPiece::mergePerB(std::vector<SimPieceSegment> segments) {
+  std::vector<SimPieceSegment> mergedSegments;
+  std::sort(segments.begin(), segments.end(), lessByBA);
+  mergeSortedPerB(segments, 0, segments.size(), mergedSegments);
+
+  return mergedSegments;
+}
+
+std::vector<SimPieceSegment> SimPiece::mergePerBParallel(std::vector<SimPieceSegment> segments, int thread_count) {
+  thread_count = std::max(1, std::min(thread_count, static_cast<int>(segments.size())));
+  std::vector<size_t> bounds;
+  for (int i = 0; i <= thread_count; ++i) bounds.emplace_back(segments.size() * i / thread_count);
+
+  // Sort the slices, then merge neighbouring sorted runs pairwise
+  runParallel(thread_count, [&](int i) {
+    std::sort(segments.begin() + bounds[i], segments.begin() + bounds[i + 1], lessByBA);
+  });
+  for (int width = 1; width < thread_count; width *= 2) {
+    runParallel((thread_count + 2 * width - 1) / (2 * width), [&](int pair) {
+      int first = pair * 2 * width;
+      if (first + width >= thread_count) return;
+      std::inplace_merge(segments.begin() + bounds[first], segments.begin() + bounds[first + width],
+                         segments.begin() + bounds[std::min(first + 2 * width, thread_count)], lessByBA);
+    });
+  }
+
+  // Segments of one b are merged together, so the ranges only start at a new b
+  for (int i = 1; i < thread_count; ++i) {
+    bounds[i] = std::max(bounds[i], bounds[i - 1]);
+    while (bounds[i] > 0 && bounds[i] < segments.size() &&
+        segments[bounds[i]].getB() == segments[bounds[i] - 1].getB())
+      ++bounds[i];
+  }
+  std::vector<std::vector<SimPieceSegment>> range_segments(thread_count);
+  runParallel(thread_count, [&](int i) {
+    mergeSortedPerB(segments, bounds[i], bounds[i + 1], range_segments[i]);
+  });
+
+  std::vector<SimPieceSegment> mergedSegments;
+  for (auto &range : range_segments) mergedSegments.insert(mergedSegments.end(), range.begin(), range.end());
+  return mergedSegments;
+}
+
+void SimPiece::mergeSortedPerB(std::vector<SimPieceSegment> &segments, size_t begin, size_t end,
+                               std::vector<SimPieceSegment> &merged_segments) {
   double aMinTemp = -std::numeric_limits<double>::max();
   double aMaxTemp = std::numeric_limits<double>::max();
   double b = std::numeric_limits<double>::quiet_NaN();
   std::vector<long> timestamps;
-  std::vector<SimPieceSegment> mergedSegments;
-
-  std::sort(segments.begin(), segments.end(), [](SimPieceSegment& s1, SimPieceSegment& s2) {
-    if (s1.getB() == s2.getB())
-      return s1.getA() < s2.getA();
-    return s1.getB() < s2.getB();
-  });
 
-  for (size_t i = 0; i < segments.size(); ++i) {
+  for (size_t i = begin; i < end; ++i) {
     if (b != segments[i].getB()) {
       if (timestamps.size() == 1) {
-        mergedSegments.emplace_back(timestamps[0], aMinTemp, aMaxTemp, b);
+        merged_segments.emplace_back(timestamps[0], aMinTemp, aMaxTemp, b);
       } else {
         for (long timestamp : timestamps) {
-          mergedSegments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
+          merged_segments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
         }
       }
       timestamps.clear();
@@ -133,16 +354,18 @@ std::vector<SimPieceSegment> SimPiece::mergePerB(std::vector<SimPieceSegment> se
       b = segments[i].getB();
       continue;
     }
-    if (segments[i].getAMin() <= aMaxTemp && segments[i].getAMax() >= aMinTemp) {
+    double aMinMerged = std::max(aMinTemp, segments[i].getAMin());
+    double aMaxMerged = std::min(aMaxTemp, segments[i].getAMax());
+    if (aMinMerged <= aMaxMerged && !std::isnan(slopeAsFloat(aMinMerged, aMaxMerged))) {
       timestamps.emplace_back(segments[i].getInitTimestamp());
-      aMinTemp = std::max(aMinTemp, segments[i].getAMin());
-      aMaxTemp = std::min(aMaxTemp, segments[i].getAMax());
+      aMinTemp = aMinMerged;
+      aMaxTemp = aMaxMerged;
     } else {
       if (timestamps.size() == 1) {
-        mergedSegments.emplace_back(segments[i - 1]);
+        merged_segments.emplace_back(segments[i - 1]);
       } else {
         for (long timestamp : timestamps) {
-          mergedSegments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
+          merged_segments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
         }
       }
       timestamps.clear();
@@ -153,23 +376,21 @@ std::vector<SimPieceSegment> SimPiece::mergePerB(std::vector<SimPieceSegment> se
   }
   if (!timestamps.empty()) {
     if (timestamps.size() == 1) {
-      mergedSegments.emplace_back(timestamps[0], aMinTemp, aMaxTemp, b);
+      merged_segments.emplace_back(timestamps[0], aMinTemp, aMaxTemp, b);
     } else {
       for (long timestamp : timestamps) {
-        mergedSegments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
+        merged_segments.emplace_back(timestamp, aMinTemp, aMaxTemp, b);
       }
     }
   }
-
-  return mergedSegments;
 }
 
 int SimPiece::toByteArrayPerBSegments(std::vector<SimPieceSegment> segments, bool variableByte,
                                        std::ostringstream &out_stream) {
   std::map<int, std::unordered_map<double, std::vector<long>>> input;
   for (auto &segment : segments) {
-    double a = segment.getA();
-    int b = static_cast<int>(std::round(segment.getB() / epsilon_));
+    double a = slopeAsFloat(segment.getAMin(), segment.getAMax());
+    int b = static_cast<int>(std::round(segment.getB() / static_cast<float>(epsilon_)));
     long t = segment.getInitTimestamp();
     if (input.find(b) == input.end())
       input.insert(std::make_pair(b, std::unordered_map<double, std::vector<long>>()));
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <limits>
 #include <cstring>
+#include <thread>
 
 #include "point.h"
 #include "sim_piece_segment.h"
@@ -19,19 +20,51 @@
 class SimPiece {
  public:
   SimPiece(std::vector<Point> points, double epsilon);
+  // Single precision values, timestamped by their position
+  SimPiece(const std::vector<float> &values, double epsilon);
+  // Long series (e.g. a day of 86,400 points) on thread_count threads: the points are split into chunks whose
+  // segments are built in parallel, so each chunk boundary may cost one segment more than the sequential
+  // constructor; the merge then sorts and merges all segments in parallel. The serialized layout is the same.
+  SimPiece(const std::vector<Point> &points, double epsilon, int thread_count);
   SimPiece(char *input, int len, bool variableByte);
   std::vector<Point> decompress();
+  std::vector<float> decompress32();
+  // Points decompress(values, timestamps) writes: one per timestamp from the first segment to last_timestamp_
+  size_t decompressedCount() const;
+  // Writes the decompressed values into values and, unless null, their timestamps into timestamps; both must hold
+  // decompressedCount() elements. Returns the number of points.
+  size_t decompress(double *values, long *timestamps = nullptr) const;
+  // Whether decompress() may use the AVX2 kernel, for comparing it with the scalar one; both give the same values
+  static void setSimdEnabled(bool enabled);
   int toByteArray(char *dst, bool variableByte, int *timestamp_store_size);
+  // Bytes toByteArray may write at most, whatever the layout of the segments
+  size_t maxByteArraySize() const;
 
  private:
+  // Chunks shorter than this are not worth a thread
+  static constexpr int kMinChunkPoints = 4096;
+
   std::vector<SimPieceSegment> segments_;
   double epsilon_;
+  // Of the values, kept out of the fit so that rounding the reconstruction (to float, for float input) stays
+  // within epsilon_
+  double relative_margin_ = 8 * std::numeric_limits<double>::epsilon();
   long last_timestamp_;
 
   double quantization(double value);
-  int createSegment(int start_idx, std::vector<Point> points, std::vector<SimPieceSegment> &segments);
+  // The error the fit allows at value
+  double tolerance(double value) const;
+  static std::vector<Point> toPoints(const std::vector<float> &values);
+  // Fits the segment starting at start_idx to the points before end_idx, returns the index of the next segment
+  int createSegment(int start_idx, int end_idx, const std::vector<Point> &points,
+                    std::vector<SimPieceSegment> &segments);
   std::vector<SimPieceSegment> compress(std::vector<Point> points);
+  std::vector<SimPieceSegment> compressParallel(const std::vector<Point> &points, int chunk_count);
   std::vector<SimPieceSegment> mergePerB(std::vector<SimPieceSegment> segments);
+  std::vector<SimPieceSegment> mergePerBParallel(std::vector<SimPieceSegment> segments, int thread_count);
+  // Merges segments[begin, end), sorted by (b, a) and starting at a new b, into merged_segments
+  static void mergeSortedPerB(std::vector<SimPieceSegment> &segments, size_t begin, size_t end,
+                              std::vector<SimPieceSegment> &merged_segments);
   int toByteArrayPerBSegments(std::vector<SimPieceSegment> segments, bool variableByte,
                                std::ostringstream &out_stream);
   std::vector<SimPieceSegment> readMergedPerBSegments(bool variableByte, std::istringstream &in_stream);
@@ -10,23 +10,23 @@ class SimPieceSegment {
 
   SimPieceSegment(const SimPieceSegment& other) = default;
 
-  long getInitTimestamp() {
+  long getInitTimestamp() const {
     return init_timestamp_;
   }
 
-  double getAMin() {
+  double getAMin() const {
     return a_min_;
   }
 
-  double getAMax() {
+  double getAMax() const {
     return a_max_;
   }
 
-  double getA() {
+  double getA() const {
     return a_;
   }
 
-  double getB() {
+  double getB() const {
     return b_;
   }
 
@@ -20,6 +20,9 @@ extern "C" {
 //#define allNodes 131072
 //#define stateNum 65536
 
+//Bits looked up at once by decode_table(), at most; longer codes finish bit by bit
+#define HUFFMAN_DECODE_TABLE_BITS 10
+
 typedef struct node_t {
 	struct node_t *left, *right;
 	size_t freq;
@@ -53,6 +56,7 @@ void init_static(HuffmanTree *huffmanTree, int *s, size_t length);
 void encode(HuffmanTree *huffmanTree, int *s, size_t length, unsigned char *out, size_t *outSize);
 
 void decode(unsigned char *s, size_t targetLength, node t, int *out);
+void decode_table(unsigned char *s, size_t targetLength, node t, int *out);
 void decode_MSST19(unsigned char *s, size_t targetLength, node t, int *out, int maxBits);
 
 void pad_tree_uchar(HuffmanTree* huffmanTree, unsigned char* L, unsigned char* R, unsigned int* C, unsigned char* t, unsigned int i, node root);
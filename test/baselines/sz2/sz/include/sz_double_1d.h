@@ -0,0 +1,138 @@
+/**
+ *  @file sz_double_1d.h
+ *  @brief Header file for sz_double_1d.c, the fast path for short 1-D blocks (time series)
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#ifndef _SZ_Double_1D_H
+#define _SZ_Double_1D_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * SZ_compress_args() is built for large scientific arrays: it samples the data to optimize the number of
+ * intervals, serializes the whole Huffman tree (7 bytes per node) and packs a TightDataPointStorageD, and
+ * allocates a Huffman tree pool for 2^16 states per call. On a block of 1000 values these fixed costs dominate
+ * both the time and the output. The fast path keeps SZ's 1-D predictor (the previous decompressed value) and
+ * linear-scaling quantization, with an absolute error bound, and drops the rest:
+ *
+ * - one pass quantizes the block and counts the codes, tracking the value range on the way;
+ * - the quantization range is fixed (SZ_1D_RADIUS intervals on each side), so there is no interval search;
+ * - the Huffman code is canonical and at most SZ_1D_MAX_CODE_LENGTH bits long, so the block stores only the
+ *   code lengths of the codes it uses;
+ * - the working memory lives in an SZ1DContext, reused by every block.
+ *
+ * Layout: a mode byte (with the flags of series blocks in the high bits), then for
+ *   SZ_1D_CONSTANT: one double, within the bound of every value
+ *   SZ_1D_RAW: the values
+ *   SZ_1D_HUFFMAN: the bound (double), the code table (varint symbol count, varint symbol gaps, 4-bit lengths)
+ *     unless SZ_1D_REUSED_TABLE, varint count of unpredictable values, those values, and the Huffman stream.
+ * The value count is not stored; the caller passes it back to decompression, as for SZ_decompress_args().
+ * */
+
+#define SZ_1D_RADIUS 32768
+#define SZ_1D_MAX_CODE_LENGTH 15
+//symbol 0 marks an unpredictable value, symbol z+1 the zigzag-mapped quantization code z
+#define SZ_1D_SYMBOLS (2*SZ_1D_RADIUS)
+
+#define SZ_1D_CONSTANT 0
+#define SZ_1D_RAW 1
+#define SZ_1D_HUFFMAN 2
+#define SZ_1D_MODE_MASK 0x0f
+//flags of series blocks in the mode byte
+#define SZ_1D_KEYFRAME 0x10 //decodable on its own
+#define SZ_1D_TEMPORAL 0x20 //predicted from the previous decompressed block, value by value
+#define SZ_1D_REUSED_TABLE 0x40 //no code table, the one of the last block that stored one
+
+//Upper bound of the compressed size of n values (SZ_1D_RAW)
+#define SZ_1D_MAX_COMPRESSED_SIZE(n) (1+8*(size_t)(n))
+
+typedef struct SZ1DContext
+{
+	size_t capacity; //values the per-value buffers hold
+
+	int* symbols; //per value
+	double* unpredictable; //per value, the unpredictable ones in order
+	uint32_t* freq; //per symbol, zero outside of a block
+	unsigned char* codeLength; //per symbol
+	uint32_t* code; //per symbol
+
+	uint32_t* used; //the symbols of the block
+	uint32_t* sorted; //the symbols of the block by (code length, symbol)
+	uint64_t* sortKey; //Huffman construction, (frequency, symbol) per symbol of the block
+	uint32_t* nodeWeight; //Huffman construction, 2*SZ_1D_SYMBOLS
+	uint32_t* nodeParent;
+
+	//the code table kept for the next blocks of a series, by symbol and as a symbol list
+	unsigned char* tableLength;
+	uint32_t* tableSymbols;
+	size_t tableSize;
+} SZ1DContext;
+
+/**
+ * State of one series, on the compressing or the decompressing side; blocks must be decompressed in the order
+ * they were compressed, starting from a keyframe.
+ *
+ * Every keyframeInterval-th block is a keyframe, compressed as SZ_1D_compress_double() does. The blocks in
+ * between continue the series: the previous-value predictor starts from the last decompressed value of the
+ * previous block instead of 0, and a block reuses the last code table when that is smaller than its own. A
+ * block of the same length as the previous one is predicted from the previous decompressed block, value i
+ * from value i (SZ_TEMPORAL_COMPRESSION's predictor), when that has the smaller absolute errors on it.
+ * */
+typedef struct SZ1DSeries
+{
+	SZ1DContext* ctx;
+	unsigned int keyframeInterval;
+	size_t blockCount;
+
+	double* previous; //the previous decompressed block, previousLength values (0 before a keyframe)
+	size_t previousLength;
+	double* current;
+	size_t capacity;
+
+	//blocks by kind, compressing side
+	size_t keyframes;
+	size_t temporalBlocks;
+	size_t reusedTables;
+} SZ1DSeries;
+
+SZ1DContext* SZ_1D_createContext();
+void SZ_1D_releaseContext(SZ1DContext* ctx);
+
+/**
+ * Compresses n values with |data[i] - decompressed[i]| <= absErrBound into out, which must hold
+ * SZ_1D_MAX_COMPRESSED_SIZE(n) bytes, and returns the compressed size
+ * */
+size_t SZ_1D_compress_double(SZ1DContext* ctx, const double* data, size_t n, double absErrBound, unsigned char* out);
+
+/**
+ * Decompresses the n values of the size bytes at bytes into out; returns SZ_SCES, or SZ_NSCS for a corrupt
+ * block
+ * */
+int SZ_1D_decompress_double(SZ1DContext* ctx, const unsigned char* bytes, size_t size, size_t n, double* out);
+
+SZ1DSeries* SZ_1D_createSeries(unsigned int keyframeInterval);
+void SZ_1D_releaseSeries(SZ1DSeries* series);
+
+//The next block of the series, as SZ_1D_compress_double()
+size_t SZ_1D_compress_series_double(SZ1DSeries* series, const double* data, size_t n, double absErrBound,
+	unsigned char* out);
+
+//The next block of the series; SZ_NSCS for a block that needs a predecessor the series has not decompressed
+int SZ_1D_decompress_series_double(SZ1DSeries* series, const unsigned char* bytes, size_t size, size_t n,
+	double* out);
+
+//Whether the block starts a series of its own, for random access
+int SZ_1D_isKeyframe(const unsigned char* bytes, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ----- #ifndef _SZ_Double_1D_H  ----- */
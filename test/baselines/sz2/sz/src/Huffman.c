@@ -342,6 +342,146 @@ void decode(unsigned char *s, size_t targetLength, node t, int *out)
 	return;
 }
 
+/**
+ * One entry of the decode_table() lookup table, indexed by the next tableBits bits of the stream.
+ * len>0: those bits start with the code of the leaf n, which is len bits long.
+ * len==0: the code is longer than tableBits; n is the inner node reached after tableBits bits.
+ * */
+typedef struct HuffmanDecodeEntry {
+	node n;
+	unsigned char len;
+} HuffmanDecodeEntry;
+
+/**
+ * Depth of the shallowest leaf (*minLen) and of the deepest one (*maxLen), the latter capped at limit
+ * */
+static void huffman_code_lengths(node n, int depth, int limit, int *minLen, int *maxLen)
+{
+	if(n == NULL)
+		return;
+	if(n->t)
+	{
+		if(depth < *minLen)
+			*minLen = depth;
+		if(depth > *maxLen)
+			*maxLen = depth;
+		return;
+	}
+	if(depth == limit)
+	{
+		*maxLen = limit;
+		return;
+	}
+	huffman_code_lengths(n->left, depth+1, limit, minLen, maxLen);
+	huffman_code_lengths(n->right, depth+1, limit, minLen, maxLen);
+}
+
+static void fill_decode_table(node n, int depth, unsigned int prefix, int tableBits, HuffmanDecodeEntry *table)
+{
+	if(n == NULL)
+		return;
+	if(n->t)
+	{
+		//every window starting with the code of n
+		unsigned int first = prefix << (tableBits - depth), span = 1U << (tableBits - depth), k;
+		for(k = 0; k < span; k++)
+		{
+			table[first+k].n = n;
+			table[first+k].len = (unsigned char)depth;
+		}
+		return;
+	}
+	if(depth == tableBits)
+	{
+		table[prefix].n = n;
+		table[prefix].len = 0;
+		return;
+	}
+	fill_decode_table(n->left, depth+1, prefix << 1, tableBits, table);
+	fill_decode_table(n->right, depth+1, (prefix << 1) | 1, tableBits, table);
+}
+
+/**
+ * The 64 stream bits starting at byte p, most significant first
+ * */
+static inline uint64_t load_bits_bigEndian(const unsigned char *p)
+{
+	return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+		((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+/**
+ * Same output as decode(), from a lookup table over the next tableBits bits instead of one tree step per bit.
+ * The codes are the ones of the stored tree, which are not canonical, so the table is filled by walking the
+ * tree once. Codes longer than the table continue bit by bit from the node the table stops at.
+ *
+ * The stream length is not known here, only targetLength, so the stream is read 8 bytes at a time only while
+ * the codes still to come (at least minLen bits each) cover those bytes; the last symbols are decoded bit by bit.
+ * */
+void decode_table(unsigned char *s, size_t targetLength, node t, int *out)
+{
+	size_t i = 0, count = 0; //i is the bit index in s
+	node n = t;
+
+	if(n->t) //root->t==1 means that all state values are the same (constant)
+	{
+		for(count=0;count<targetLength;count++)
+			out[count] = n->c;
+		return;
+	}
+
+	int minLen = 255, tableBits = 0;
+	huffman_code_lengths(t, 0, HUFFMAN_DECODE_TABLE_BITS, &minLen, &tableBits);
+	HuffmanDecodeEntry* table = (HuffmanDecodeEntry*)malloc((1U << tableBits)*sizeof(HuffmanDecodeEntry));
+	fill_decode_table(t, 0, 0, tableBits, table);
+
+	while(count < targetLength && (targetLength - count) * minLen >= 64)
+	{
+		int shift = i%8;
+		uint64_t window = load_bits_bigEndian(s + (i>>3)) << shift;
+		int leftBits = 64 - shift;
+		while(leftBits >= tableBits && count < targetLength)
+		{
+			HuffmanDecodeEntry entry = table[window >> (64 - tableBits)];
+			if(entry.len == 0)
+				break;
+			out[count++] = entry.n->c;
+			window <<= entry.len;
+			leftBits -= entry.len;
+			i += entry.len;
+		}
+		if(leftBits >= tableBits && count < targetLength) //a code longer than the table
+		{
+			i += tableBits;
+			n = table[window >> (64 - tableBits)].n;
+			while(!n->t)
+			{
+				if(((s[i>>3] >> (7-i%8)) & 0x01) == 0)
+					n = n->left;
+				else
+					n = n->right;
+				i++;
+			}
+			out[count++] = n->c;
+		}
+	}
+
+	for(n = t; count < targetLength; i++)
+	{
+		if(((s[i>>3] >> (7-i%8)) & 0x01) == 0)
+			n = n->left;
+		else
+			n = n->right;
+
+		if (n->t) {
+			out[count] = n->c;
+			n = t;
+			count++;
+		}
+	}
+	free(table);
+}
+
 void decode_MSST19(unsigned char *s, size_t targetLength, node t, int *out, int maxBits)
 {
 	size_t count = 0;
@@ -885,7 +1025,7 @@ void decode_withTree(HuffmanTree* huffmanTree, unsigned char *s, size_t targetLe
 		encodeStartIndex = 1+2*nodeCount*sizeof(unsigned short)+nodeCount*sizeof(unsigned char)+nodeCount*sizeof(unsigned int);
 	else
 		encodeStartIndex = 1+3*nodeCount*sizeof(unsigned int)+nodeCount*sizeof(unsigned char);
-	decode(s+8+encodeStartIndex, targetLength, root, out);
+	decode_table(s+8+encodeStartIndex, targetLength, root, out);
 }
 
 void decode_withTree_MSST19(HuffmanTree* huffmanTree, unsigned char *s, size_t targetLength, int *out, int maxBits)
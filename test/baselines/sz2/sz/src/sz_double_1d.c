@@ -0,0 +1,742 @@
+/**
+ *  @file sz_double_1d.c
+ *  @brief Fast path for short 1-D blocks of doubles (time series), see sz_double_1d.h
+ *  (C) 2016 by Mathematics and Computer Science (MCS), Argonne National Laboratory.
+ *      See COPYRIGHT in top-level directory.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "defines.h"
+#include "sz_double_1d.h"
+
+//code lengths up to this many bits are decoded with one table lookup
+#define SZ_1D_FAST_BITS 8
+
+SZ1DContext* SZ_1D_createContext()
+{
+	SZ1DContext* ctx = (SZ1DContext*)malloc(sizeof(SZ1DContext));
+	memset(ctx, 0, sizeof(SZ1DContext));
+	ctx->freq = (uint32_t*)calloc(SZ_1D_SYMBOLS, sizeof(uint32_t));
+	ctx->codeLength = (unsigned char*)calloc(SZ_1D_SYMBOLS, sizeof(unsigned char));
+	ctx->code = (uint32_t*)calloc(SZ_1D_SYMBOLS, sizeof(uint32_t));
+	ctx->used = (uint32_t*)malloc(SZ_1D_SYMBOLS*sizeof(uint32_t));
+	ctx->sorted = (uint32_t*)malloc(SZ_1D_SYMBOLS*sizeof(uint32_t));
+	ctx->sortKey = (uint64_t*)malloc(SZ_1D_SYMBOLS*sizeof(uint64_t));
+	ctx->tableSymbols = (uint32_t*)malloc(SZ_1D_SYMBOLS*sizeof(uint32_t));
+	ctx->tableLength = (unsigned char*)calloc(SZ_1D_SYMBOLS, sizeof(unsigned char));
+	ctx->nodeWeight = (uint32_t*)malloc(2*SZ_1D_SYMBOLS*sizeof(uint32_t));
+	ctx->nodeParent = (uint32_t*)malloc(2*SZ_1D_SYMBOLS*sizeof(uint32_t));
+	return ctx;
+}
+
+void SZ_1D_releaseContext(SZ1DContext* ctx)
+{
+	free(ctx->symbols);
+	free(ctx->unpredictable);
+	free(ctx->freq);
+	free(ctx->codeLength);
+	free(ctx->code);
+	free(ctx->used);
+	free(ctx->sorted);
+	free(ctx->sortKey);
+	free(ctx->tableSymbols);
+	free(ctx->tableLength);
+	free(ctx->nodeWeight);
+	free(ctx->nodeParent);
+	free(ctx);
+}
+
+static void reserve(SZ1DContext* ctx, size_t n)
+{
+	if(n <= ctx->capacity)
+		return;
+	free(ctx->symbols);
+	free(ctx->unpredictable);
+	ctx->symbols = (int*)malloc(n*sizeof(int));
+	ctx->unpredictable = (double*)malloc(n*sizeof(double));
+	ctx->capacity = n;
+}
+
+/**
+ * The value the decompressor rebuilds from the prediction and the quantization code; the compressor checks the
+ * bound on this same expression
+ * */
+static inline double reconstruct(double pred, double interval, int q)
+{
+	return pred + interval*q;
+}
+
+//the prediction of the next value, from the decompressed one
+static inline double next_prediction(double value)
+{
+	return isfinite(value) ? value : 0;
+}
+
+static inline unsigned char* put_varint(unsigned char* p, size_t value)
+{
+	while(value >= 0x80)
+	{
+		*p++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*p++ = (unsigned char)value;
+	return p;
+}
+
+static inline const unsigned char* get_varint(const unsigned char* p, const unsigned char* end, size_t* value)
+{
+	size_t v = 0;
+	int shift = 0;
+	while(p < end && shift < 64)
+	{
+		unsigned char byte = *p++;
+		v |= (size_t)(byte & 0x7f) << shift;
+		if(byte < 0x80)
+		{
+			*value = v;
+			return p;
+		}
+		shift += 7;
+	}
+	return NULL;
+}
+
+static inline size_t varint_size(size_t value)
+{
+	size_t size = 1;
+	while(value >= 0x80)
+	{
+		value >>= 7;
+		size++;
+	}
+	return size;
+}
+
+static int compare_uint32(const void* a, const void* b)
+{
+	uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+	return (x > y) - (x < y);
+}
+
+static int compare_uint64(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+/**
+ * Code lengths of the m symbols in ctx->used, at most SZ_1D_MAX_CODE_LENGTH bits, into ctx->codeLength.
+ * Huffman lengths from the two-queue construction over the symbols sorted by frequency, then limited as in
+ * JPEG (ITU T.81 Annex K.3): a pair of leaves below the limit moves up one level, and a leaf at a shallower
+ * level moves down to take the other slot.
+ * */
+static void build_code_lengths(SZ1DContext* ctx, size_t m)
+{
+	uint32_t* leaf = ctx->sorted;
+	uint32_t* weight = ctx->nodeWeight;
+	uint32_t* parent = ctx->nodeParent;
+	size_t i;
+	if(m == 1)
+	{
+		ctx->codeLength[ctx->used[0]] = 1;
+		return;
+	}
+
+	//by frequency, then by symbol
+	for(i = 0; i < m; i++)
+		ctx->sortKey[i] = ((uint64_t)ctx->freq[ctx->used[i]] << 32) | ctx->used[i];
+	qsort(ctx->sortKey, m, sizeof(uint64_t), compare_uint64);
+	for(i = 0; i < m; i++)
+	{
+		leaf[i] = (uint32_t)ctx->sortKey[i];
+		weight[i] = (uint32_t)(ctx->sortKey[i] >> 32);
+	}
+
+	//the leaves are 0..m-1 by weight, the inner nodes m..2m-2 in the order they are made, which is by weight too
+	size_t nextLeaf = 0, nextInner = m, node;
+	for(node = m; node < 2*m-1; node++)
+	{
+		size_t child[2], k;
+		for(k = 0; k < 2; k++)
+		{
+			if(nextLeaf < m && (nextInner == node || weight[nextLeaf] <= weight[nextInner]))
+				child[k] = nextLeaf++;
+			else
+				child[k] = nextInner++;
+		}
+		weight[node] = weight[child[0]] + weight[child[1]];
+		parent[child[0]] = parent[child[1]] = (uint32_t)node;
+	}
+
+	//depths, reusing weight; a Huffman tree over at most 2^32 values is less than 64 levels deep
+	unsigned int bits[64];
+	memset(bits, 0, sizeof(bits));
+	weight[2*m-2] = 0;
+	for(node = 2*m-2; node-- > 0;)
+	{
+		weight[node] = weight[parent[node]] + 1;
+		if(node < m)
+			bits[weight[node]]++;
+	}
+
+	int len, maxLen = 63;
+	while(bits[maxLen] == 0)
+		maxLen--;
+	for(len = maxLen; len > SZ_1D_MAX_CODE_LENGTH; len--)
+	{
+		while(bits[len] > 0)
+		{
+			int j = len - 2;
+			while(bits[j] == 0)
+				j--;
+			bits[len] -= 2;
+			bits[len-1]++;
+			bits[j+1] += 2;
+			bits[j]--;
+		}
+	}
+
+	//the least frequent symbols get the longest codes
+	i = 0;
+	for(len = SZ_1D_MAX_CODE_LENGTH; len > 0; len--)
+	{
+		unsigned int k;
+		for(k = 0; k < bits[len]; k++)
+			ctx->codeLength[leaf[i++]] = (unsigned char)len;
+	}
+}
+
+/**
+ * Canonical order and codes of the m symbols in ctx->used, which must be sorted by symbol: ctx->sorted by
+ * (length, symbol), and first code, count and first index in ctx->sorted of every length.
+ * SZ_NSCS if the lengths leave too few codes of some length.
+ * */
+static int build_canonical_code(SZ1DContext* ctx, size_t m, uint32_t* firstCode, uint32_t* count, uint32_t* offset)
+{
+	size_t i;
+	int len;
+	memset(count, 0, (SZ_1D_MAX_CODE_LENGTH+1)*sizeof(uint32_t));
+	for(i = 0; i < m; i++)
+		count[ctx->codeLength[ctx->used[i]]]++;
+	uint32_t code = 0, index = 0;
+	for(len = 1; len <= SZ_1D_MAX_CODE_LENGTH; len++)
+	{
+		firstCode[len] = code;
+		offset[len] = index;
+		if(code + count[len] > 1U << len)
+			return SZ_NSCS;
+		code = (code + count[len]) << 1;
+		index += count[len];
+	}
+	uint32_t next[SZ_1D_MAX_CODE_LENGTH+1];
+	memcpy(next, offset, sizeof(next));
+	for(i = 0; i < m; i++)
+	{
+		uint32_t symbol = ctx->used[i];
+		ctx->sorted[next[ctx->codeLength[symbol]]++] = symbol;
+	}
+	for(len = 1; len <= SZ_1D_MAX_CODE_LENGTH; len++)
+	{
+		uint32_t k;
+		for(k = 0; k < count[len]; k++)
+			ctx->code[ctx->sorted[offset[len]+k]] = firstCode[len] + k;
+	}
+	return SZ_SCES;
+}
+
+static void clear_table(SZ1DContext* ctx)
+{
+	size_t i;
+	for(i = 0; i < ctx->tableSize; i++)
+		ctx->tableLength[ctx->tableSymbols[i]] = 0;
+	ctx->tableSize = 0;
+}
+
+//keeps the code table of the block in ctx for blocks that reuse it
+static void keep_table(SZ1DContext* ctx, size_t m)
+{
+	size_t i;
+	clear_table(ctx);
+	for(i = 0; i < m; i++)
+	{
+		ctx->tableSymbols[i] = ctx->used[i];
+		ctx->tableLength[ctx->used[i]] = ctx->codeLength[ctx->used[i]];
+	}
+	ctx->tableSize = m;
+}
+
+//makes the kept code table the one of the block
+static size_t use_kept_table(SZ1DContext* ctx)
+{
+	size_t i;
+	for(i = 0; i < ctx->tableSize; i++)
+	{
+		ctx->used[i] = ctx->tableSymbols[i];
+		ctx->codeLength[ctx->used[i]] = ctx->tableLength[ctx->used[i]];
+	}
+	return ctx->tableSize;
+}
+
+/**
+ * Compresses a block whose values are predicted from reference (same position in the previous decompressed
+ * block), or from the previous decompressed value, starting from seed, if reference is NULL.
+ * flags go into the mode byte. keepTable: keep the code table of the block in ctx; reuseTable: the kept table
+ * may be used for this block when that is smaller than a table of its own.
+ * decompressed: if not NULL, receives what the decompressor will return.
+ * */
+static size_t compress_block(SZ1DContext* ctx, const double* data, size_t n, double absErrBound,
+	const double* reference, double seed, unsigned char flags, int keepTable, int reuseTable, unsigned char* out,
+	double* decompressed)
+{
+	size_t i, m = 0, unpredictableCount = 0;
+	double interval = 2*absErrBound, pred = seed;
+	double minValue = INFINITY, maxValue = -INFINITY;
+	int finite = 1;
+	reserve(ctx, n);
+
+	//quantize, count the symbols and track the range in one pass
+	for(i = 0; i < n; i++)
+	{
+		double value = data[i];
+		if(reference != NULL)
+			pred = next_prediction(reference[i]);
+		double diff = value - pred;
+		double decompressedValue = value;
+		int symbol = 0;
+		if(fabs(diff) < (2*SZ_1D_RADIUS-1)*absErrBound)
+		{
+			int itvNum = (int)(fabs(diff)/absErrBound) + 1;
+			int q = diff < 0 ? -(itvNum/2) : itvNum/2;
+			double quantized = reconstruct(pred, interval, q);
+			if(fabs(quantized - value) <= absErrBound)
+			{
+				symbol = (int)(((unsigned int)q << 1) ^ (unsigned int)(q >> 31)) + 1;
+				decompressedValue = quantized;
+			}
+		}
+		if(symbol == 0)
+			ctx->unpredictable[unpredictableCount++] = value;
+		pred = next_prediction(decompressedValue);
+		if(decompressed != NULL)
+			decompressed[i] = decompressedValue;
+		ctx->symbols[i] = symbol;
+		if(ctx->freq[symbol]++ == 0)
+			ctx->used[m++] = (uint32_t)symbol;
+
+		if(value < minValue)
+			minValue = value;
+		if(value > maxValue)
+			maxValue = value;
+		finite &= isfinite(value) != 0;
+	}
+
+	size_t size = SZ_1D_MAX_COMPRESSED_SIZE(n);
+	unsigned char mode = SZ_1D_RAW;
+	int reuse = 0;
+	double constant = minValue + (maxValue - minValue)/2;
+	if(n > 0 && finite && maxValue - constant <= absErrBound && constant - minValue <= absErrBound)
+	{
+		mode = SZ_1D_CONSTANT;
+		size = 1 + sizeof(double);
+	}
+	else if(n > 0)
+	{
+		qsort(ctx->used, m, sizeof(uint32_t), compare_uint32);
+		build_code_lengths(ctx, m);
+		uint64_t streamBits = 0, keptStreamBits = 0;
+		size_t tableSize = varint_size(m) + (m+1)/2;
+		reuse = reuseTable && ctx->tableSize > 0;
+		for(i = 0; i < m; i++)
+		{
+			uint32_t symbol = ctx->used[i];
+			streamBits += (uint64_t)ctx->freq[symbol]*ctx->codeLength[symbol];
+			tableSize += varint_size(i == 0 ? symbol : symbol - ctx->used[i-1] - 1);
+			keptStreamBits += (uint64_t)ctx->freq[symbol]*ctx->tableLength[symbol];
+			reuse &= ctx->tableLength[symbol] > 0;
+		}
+		size_t fixedSize = 1 + sizeof(double) + varint_size(unpredictableCount) + unpredictableCount*sizeof(double);
+		size_t huffmanSize = fixedSize + tableSize + (size_t)((streamBits+7)/8);
+		size_t keptTableSize = fixedSize + (size_t)((keptStreamBits+7)/8);
+		if(reuse && keptTableSize <= huffmanSize)
+			huffmanSize = keptTableSize;
+		else
+			reuse = 0;
+		if(huffmanSize < size)
+		{
+			mode = SZ_1D_HUFFMAN;
+			size = huffmanSize;
+		}
+	}
+	for(i = 0; i < m; i++)
+		ctx->freq[ctx->used[i]] = 0;
+
+	unsigned char* p = out;
+	if(mode == SZ_1D_CONSTANT)
+	{
+		*p++ = mode | flags;
+		memcpy(p, &constant, sizeof(double));
+		if(decompressed != NULL)
+			for(i = 0; i < n; i++)
+				decompressed[i] = constant;
+	}
+	else if(mode == SZ_1D_RAW)
+	{
+		*p++ = mode | flags;
+		memcpy(p, data, n*sizeof(double));
+		if(decompressed != NULL)
+			memcpy(decompressed, data, n*sizeof(double));
+	}
+	else
+	{
+		*p++ = mode | flags | (reuse ? SZ_1D_REUSED_TABLE : 0);
+		uint32_t firstCode[SZ_1D_MAX_CODE_LENGTH+1], count[SZ_1D_MAX_CODE_LENGTH+1], offset[SZ_1D_MAX_CODE_LENGTH+1];
+		if(reuse)
+			m = use_kept_table(ctx);
+		else if(keepTable)
+			keep_table(ctx, m);
+		build_canonical_code(ctx, m, firstCode, count, offset);
+
+		memcpy(p, &absErrBound, sizeof(double));
+		p += sizeof(double);
+		if(!reuse)
+		{
+			p = put_varint(p, m);
+			for(i = 0; i < m; i++)
+				p = put_varint(p, i == 0 ? ctx->used[0] : ctx->used[i] - ctx->used[i-1] - 1);
+			for(i = 0; i < m; i += 2)
+				*p++ = (unsigned char)((ctx->codeLength[ctx->used[i]] << 4) |
+					(i+1 < m ? ctx->codeLength[ctx->used[i+1]] : 0));
+		}
+		p = put_varint(p, unpredictableCount);
+		memcpy(p, ctx->unpredictable, unpredictableCount*sizeof(double));
+		p += unpredictableCount*sizeof(double);
+
+		//most significant bit first
+		uint64_t buffer = 0;
+		int bufferBits = 0;
+		for(i = 0; i < n; i++)
+		{
+			int symbol = ctx->symbols[i];
+			int len = ctx->codeLength[symbol];
+			buffer = (buffer << len) | ctx->code[symbol];
+			bufferBits += len;
+			while(bufferBits >= 8)
+			{
+				bufferBits -= 8;
+				*p++ = (unsigned char)(buffer >> bufferBits);
+			}
+		}
+		if(bufferBits > 0)
+			*p++ = (unsigned char)(buffer << (8 - bufferBits));
+	}
+	return size;
+}
+
+/**
+ * Decompresses a block of compress_block(); reference and seed as there, the caller picks them from the flags
+ * */
+static int decompress_block(SZ1DContext* ctx, const unsigned char* bytes, size_t size, size_t n,
+	const double* reference, double seed, int keepTable, double* out)
+{
+	const unsigned char* p = bytes;
+	const unsigned char* end = bytes + size;
+	size_t i, m, unpredictableCount;
+	if(size < 1)
+		return SZ_NSCS;
+	unsigned char mode = *p & SZ_1D_MODE_MASK, flags = *p & ~SZ_1D_MODE_MASK;
+	p++;
+	if((flags & SZ_1D_TEMPORAL) && reference == NULL)
+		return SZ_NSCS;
+	if(mode == SZ_1D_CONSTANT)
+	{
+		double constant;
+		if(size < 1 + sizeof(double))
+			return SZ_NSCS;
+		memcpy(&constant, p, sizeof(double));
+		for(i = 0; i < n; i++)
+			out[i] = constant;
+		return SZ_SCES;
+	}
+	if(mode == SZ_1D_RAW)
+	{
+		if(size < SZ_1D_MAX_COMPRESSED_SIZE(n))
+			return SZ_NSCS;
+		memcpy(out, p, n*sizeof(double));
+		return SZ_SCES;
+	}
+	if(mode != SZ_1D_HUFFMAN || size < 1 + sizeof(double))
+		return SZ_NSCS;
+
+	double absErrBound, interval;
+	memcpy(&absErrBound, p, sizeof(double));
+	p += sizeof(double);
+	interval = 2*absErrBound;
+
+	if(flags & SZ_1D_REUSED_TABLE)
+	{
+		if(!keepTable || ctx->tableSize == 0)
+			return SZ_NSCS;
+		m = use_kept_table(ctx);
+	}
+	else
+	{
+		p = get_varint(p, end, &m);
+		if(p == NULL || m == 0 || m > SZ_1D_SYMBOLS)
+			return SZ_NSCS;
+		size_t symbol = 0;
+		for(i = 0; i < m; i++)
+		{
+			size_t gap;
+			p = get_varint(p, end, &gap);
+			if(p == NULL || gap >= SZ_1D_SYMBOLS)
+				return SZ_NSCS;
+			symbol = i == 0 ? gap : symbol + gap + 1;
+			if(symbol >= SZ_1D_SYMBOLS)
+				return SZ_NSCS;
+			ctx->used[i] = (uint32_t)symbol;
+		}
+		if((size_t)(end - p) < (m+1)/2)
+			return SZ_NSCS;
+		//Kraft sum in units of the longest code: a prefix code, and a complete one unless it has one symbol
+		uint32_t kraft = 0;
+		for(i = 0; i < m; i++)
+		{
+			unsigned char len = i%2 == 0 ? p[i/2] >> 4 : p[i/2] & 0x0f;
+			if(len == 0)
+				return SZ_NSCS;
+			ctx->codeLength[ctx->used[i]] = len;
+			kraft += 1U << (SZ_1D_MAX_CODE_LENGTH - len);
+		}
+		if(kraft > 1U << SZ_1D_MAX_CODE_LENGTH || (m > 1 && kraft != 1U << SZ_1D_MAX_CODE_LENGTH))
+			return SZ_NSCS;
+		p += (m+1)/2;
+		if(keepTable)
+			keep_table(ctx, m);
+	}
+	p = get_varint(p, end, &unpredictableCount);
+	if(p == NULL || unpredictableCount > n || (size_t)(end - p) < unpredictableCount*sizeof(double))
+		return SZ_NSCS;
+	const unsigned char* unpredictable = p;
+	p += unpredictableCount*sizeof(double);
+
+	uint32_t firstCode[SZ_1D_MAX_CODE_LENGTH+1], count[SZ_1D_MAX_CODE_LENGTH+1], offset[SZ_1D_MAX_CODE_LENGTH+1];
+	if(build_canonical_code(ctx, m, firstCode, count, offset) != SZ_SCES)
+		return SZ_NSCS;
+
+	//the symbol index in ctx->sorted and the length of every code up to SZ_1D_FAST_BITS bits, by its first bits
+	uint32_t fastIndex[1 << SZ_1D_FAST_BITS];
+	unsigned char fastLength[1 << SZ_1D_FAST_BITS];
+	memset(fastLength, 0, sizeof(fastLength));
+	int len;
+	for(len = 1; len <= SZ_1D_FAST_BITS; len++)
+	{
+		uint32_t k;
+		for(k = 0; k < count[len]; k++)
+		{
+			uint32_t first = (firstCode[len] + k) << (SZ_1D_FAST_BITS - len);
+			uint32_t span = 1U << (SZ_1D_FAST_BITS - len), e;
+			for(e = 0; e < span; e++)
+			{
+				fastIndex[first+e] = offset[len] + k;
+				fastLength[first+e] = (unsigned char)len;
+			}
+		}
+	}
+
+	uint64_t buffer = 0; //the next bufferBits bits of the stream, from the top
+	int bufferBits = 0;
+	size_t unpredictableIndex = 0;
+	double pred = seed;
+	for(i = 0; i < n; i++)
+	{
+		while(bufferBits <= 56)
+		{
+			buffer |= (uint64_t)(p < end ? *p++ : 0) << (56 - bufferBits);
+			bufferBits += 8;
+		}
+		uint32_t index;
+		unsigned int top = (unsigned int)(buffer >> (64 - SZ_1D_FAST_BITS));
+		len = fastLength[top];
+		if(len > 0)
+		{
+			index = fastIndex[top];
+		}
+		else
+		{
+			for(len = SZ_1D_FAST_BITS+1; len <= SZ_1D_MAX_CODE_LENGTH; len++)
+			{
+				uint32_t code = (uint32_t)(buffer >> (64 - len));
+				if(code - firstCode[len] < count[len])
+					break;
+			}
+			if(len > SZ_1D_MAX_CODE_LENGTH)
+				return SZ_NSCS;
+			index = offset[len] + (uint32_t)(buffer >> (64 - len)) - firstCode[len];
+		}
+		buffer <<= len;
+		bufferBits -= len;
+
+		uint32_t s = ctx->sorted[index];
+		double value;
+		if(s == 0)
+		{
+			if(unpredictableIndex == unpredictableCount)
+				return SZ_NSCS;
+			memcpy(&value, unpredictable + unpredictableIndex++*sizeof(double), sizeof(double));
+		}
+		else
+		{
+			uint32_t z = s - 1;
+			int q = (int)(z >> 1) ^ -(int)(z & 1);
+			if(reference != NULL)
+				pred = next_prediction(reference[i]);
+			value = reconstruct(pred, interval, q);
+		}
+		out[i] = value;
+		pred = next_prediction(value);
+	}
+	return SZ_SCES;
+}
+
+size_t SZ_1D_compress_double(SZ1DContext* ctx, const double* data, size_t n, double absErrBound, unsigned char* out)
+{
+	return compress_block(ctx, data, n, absErrBound, NULL, 0, 0, 0, 0, out, NULL);
+}
+
+int SZ_1D_decompress_double(SZ1DContext* ctx, const unsigned char* bytes, size_t size, size_t n, double* out)
+{
+	return decompress_block(ctx, bytes, size, n, NULL, 0, 0, out);
+}
+
+SZ1DSeries* SZ_1D_createSeries(unsigned int keyframeInterval)
+{
+	SZ1DSeries* series = (SZ1DSeries*)malloc(sizeof(SZ1DSeries));
+	memset(series, 0, sizeof(SZ1DSeries));
+	series->ctx = SZ_1D_createContext();
+	series->keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+	return series;
+}
+
+void SZ_1D_releaseSeries(SZ1DSeries* series)
+{
+	SZ_1D_releaseContext(series->ctx);
+	free(series->previous);
+	free(series->current);
+	free(series);
+}
+
+static void reserve_series(SZ1DSeries* series, size_t n)
+{
+	if(n <= series->capacity)
+		return;
+	series->previous = (double*)realloc(series->previous, n*sizeof(double));
+	free(series->current);
+	series->current = (double*)malloc(n*sizeof(double));
+	series->capacity = n;
+}
+
+/**
+ * Whether the previous block at the same position predicts the block better than the previous value, judged
+ * by the sum of absolute prediction errors on the original values
+ * */
+static int prefer_temporal(const double* data, size_t n, const double* previous)
+{
+	double sequential = fabs(data[0] - next_prediction(previous[n-1])), temporal = 0;
+	size_t i;
+	for(i = 0; i < n; i++)
+	{
+		if(i > 0)
+			sequential += fabs(data[i] - data[i-1]);
+		temporal += fabs(data[i] - previous[i]);
+	}
+	return temporal < sequential;
+}
+
+size_t SZ_1D_compress_series_double(SZ1DSeries* series, const double* data, size_t n, double absErrBound,
+	unsigned char* out)
+{
+	reserve_series(series, n);
+	int keyframe = series->blockCount % series->keyframeInterval == 0 || series->previousLength == 0;
+	const double* reference = NULL;
+	double seed = 0;
+	unsigned char flags = keyframe ? SZ_1D_KEYFRAME : 0;
+	if(keyframe)
+	{
+		clear_table(series->ctx);
+	}
+	else
+	{
+		seed = next_prediction(series->previous[series->previousLength-1]);
+		if(n > 0 && n == series->previousLength && prefer_temporal(data, n, series->previous))
+		{
+			reference = series->previous;
+			flags |= SZ_1D_TEMPORAL;
+		}
+	}
+
+	size_t size = compress_block(series->ctx, data, n, absErrBound, reference, seed, flags, 1, !keyframe, out,
+		series->current);
+	if(n > 0)
+	{
+		double* swap = series->previous;
+		series->previous = series->current;
+		series->current = swap;
+		series->previousLength = n;
+	}
+	series->blockCount++;
+	series->keyframes += keyframe;
+	series->temporalBlocks += (flags & SZ_1D_TEMPORAL) != 0;
+	series->reusedTables += (out[0] & SZ_1D_REUSED_TABLE) != 0;
+	return size;
+}
+
+int SZ_1D_decompress_series_double(SZ1DSeries* series, const unsigned char* bytes, size_t size, size_t n,
+	double* out)
+{
+	if(size < 1)
+		return SZ_NSCS;
+	unsigned char flags = bytes[0] & ~SZ_1D_MODE_MASK;
+	if(flags & SZ_1D_KEYFRAME)
+	{
+		series->previousLength = 0;
+		clear_table(series->ctx);
+	}
+	else if(series->previousLength == 0)
+	{
+		return SZ_NSCS; //a block after a keyframe this series has not read
+	}
+
+	const double* reference = NULL;
+	double seed = 0;
+	if(!(flags & SZ_1D_KEYFRAME))
+	{
+		seed = next_prediction(series->previous[series->previousLength-1]);
+		if(flags & SZ_1D_TEMPORAL)
+		{
+			if(n != series->previousLength)
+				return SZ_NSCS;
+			reference = series->previous;
+		}
+	}
+	int status = decompress_block(series->ctx, bytes, size, n, reference, seed, 1, out);
+	if(status != SZ_SCES)
+	{
+		series->previousLength = 0;
+		return status;
+	}
+	if(n > 0)
+	{
+		reserve_series(series, n);
+		memcpy(series->previous, out, n*sizeof(double));
+		series->previousLength = n;
+	}
+	series->blockCount++;
+	return SZ_SCES;
+}
+
+int SZ_1D_isKeyframe(const unsigned char* bytes, size_t size)
+{
+	return size > 0 && (bytes[0] & SZ_1D_KEYFRAME) != 0;
+}